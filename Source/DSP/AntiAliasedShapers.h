@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    First-order antiderivative anti-aliasing (ADAA) for the memoryless curves.
+
+        y[n] = (F(x[n]) - F(x[n-1])) / (x[n] - x[n-1])
+
+    where F is the closed-form antiderivative of the curve f. When the two
+    inputs are too close the quotient is ill-conditioned and f is evaluated
+    at the midpoint instead. Each stage adds half a sample of delay.
+    F is evaluated in double: it grows like x^2 and the difference of two
+    nearby values would otherwise lose most of its float precision.
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace ADAACurves
+{
+    // log (cosh (x)) without overflow for large |x|
+    inline double logCosh (double x) noexcept
+    {
+        constexpr double ln2 = 0.69314718055994530942;
+        const double ax = std::abs (x);
+        return ax + std::log1p (std::exp (-2.0 * ax)) - ln2;
+    }
+
+    // Honey stage 1: tube curve k*x / (1 + c|x|) followed by the 2nd harmonic
+    // term y + b|y|y, as one curve. With u = 1 + c|x|:
+    //   F(x) = k/c * (|x| - ln(u) / c) + b * k^2 / c^3 * (u - 2 ln(u) - 1/u)
+    struct TubeHarmonic
+    {
+        double k = 1.0, c = 0.3, b = 0.0;
+
+        double f (double x) const noexcept
+        {
+            const double y = k * x / (1.0 + c * std::abs (x));
+            return y + b * std::abs (y) * y;
+        }
+
+        double F (double x) const noexcept
+        {
+            const double u = 1.0 + c * std::abs (x);
+            const double lnU = std::log (u);
+            return k / c * (std::abs (x) - lnU / c)
+                 + b * k * k / (c * c * c) * (u - 2.0 * lnU - 1.0 / u);
+        }
+
+        bool operator== (const TubeHarmonic& o) const noexcept   { return k == o.k && c == o.c && b == o.b; }
+    };
+
+    // tanh (drive * x) / drive:  F(x) = log cosh (drive * x) / drive^2
+    struct SoftClip
+    {
+        double drive = 1.0;
+
+        double f (double x) const noexcept   { return std::tanh (drive * x) / drive; }
+        double F (double x) const noexcept   { return logCosh (drive * x) / (drive * drive); }
+
+        bool operator== (const SoftClip& o) const noexcept   { return drive == o.drive; }
+    };
+
+    // (1 - m) x + m tanh (1.2 x):  F(x) = (1 - m) x^2 / 2 + m log cosh (1.2 x) / 1.2
+    struct Transformer
+    {
+        double amount = 0.0;
+
+        double f (double x) const noexcept   { return (1.0 - amount) * x + amount * std::tanh (1.2 * x); }
+        double F (double x) const noexcept   { return (1.0 - amount) * x * x * 0.5 + amount * logCosh (1.2 * x) / 1.2; }
+
+        bool operator== (const Transformer& o) const noexcept   { return amount == o.amount; }
+    };
+}
+
+//==============================================================================
+// One channel of first-order ADAA around any curve with f() and F().
+// F(x[n-1]) is cached and reused while the curve parameters stay the same,
+// so a steady setting costs one F() per sample.
+template <typename Curve>
+class ADAA1
+{
+public:
+    void reset() noexcept
+    {
+        x1 = 0.0;
+        hasCachedF1 = false;
+    }
+
+    float process (float input, const Curve& curve) noexcept
+    {
+        const double x = input;
+        const double dx = x - x1;
+        const double Fx = curve.F (x);
+        double y;
+
+        if (std::abs (dx) < illConditionedThreshold)
+        {
+            y = curve.f (0.5 * (x + x1));
+        }
+        else
+        {
+            const double F1 = (hasCachedF1 && curve == cachedCurve) ? cachedF1 : curve.F (x1);
+            y = (Fx - F1) / dx;
+        }
+
+        x1 = x;
+        cachedF1 = Fx;
+        cachedCurve = curve;
+        hasCachedF1 = true;
+
+        return (float) y;
+    }
+
+private:
+    static constexpr double illConditionedThreshold = 1.0e-5;
+
+    double x1 = 0.0;
+    double cachedF1 = 0.0;
+    Curve cachedCurve {};
+    bool hasCachedF1 = false;
+};
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    Allocation-free biquad design.
+    Same RBJ formulas as juce::dsp::IIR::Coefficients::make*, but written
+    into plain structs so the audio thread never touches the heap.
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Normalised (a0 == 1) second-order section
+struct BiquadCoefficients
+{
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
+    float a1 = 0.0f, a2 = 0.0f;
+};
+
+namespace BiquadDesign
+{
+    inline BiquadCoefficients normalise (double b0, double b1, double b2,
+                                         double a0, double a1, double a2) noexcept
+    {
+        jassert (a0 != 0.0);
+        const double inv = 1.0 / a0;
+        return { (float) (b0 * inv), (float) (b1 * inv), (float) (b2 * inv),
+                 (float) (a1 * inv), (float) (a2 * inv) };
+    }
+
+    inline BiquadCoefficients makeLowPass (double sampleRate, double frequency, double q) noexcept
+    {
+        jassert (sampleRate > 0.0 && frequency > 0.0 && frequency <= sampleRate * 0.5 && q > 0.0);
+
+        const double n = 1.0 / std::tan (juce::MathConstants<double>::pi * frequency / sampleRate);
+        const double nSquared = n * n;
+        const double invQ = 1.0 / q;
+        const double c1 = 1.0 / (1.0 + invQ * n + nSquared);
+
+        return normalise (c1, c1 * 2.0, c1,
+                          1.0, c1 * 2.0 * (1.0 - nSquared), c1 * (1.0 - invQ * n + nSquared));
+    }
+
+    inline BiquadCoefficients makeHighPass (double sampleRate, double frequency, double q) noexcept
+    {
+        jassert (sampleRate > 0.0 && frequency > 0.0 && frequency <= sampleRate * 0.5 && q > 0.0);
+
+        const double n = std::tan (juce::MathConstants<double>::pi * frequency / sampleRate);
+        const double nSquared = n * n;
+        const double invQ = 1.0 / q;
+        const double c1 = 1.0 / (1.0 + invQ * n + nSquared);
+
+        return normalise (c1, c1 * -2.0, c1,
+                          1.0, c1 * 2.0 * (nSquared - 1.0), c1 * (1.0 - invQ * n + nSquared));
+    }
+
+    inline BiquadCoefficients makePeakFilter (double sampleRate, double frequency,
+                                              double q, double gainFactor) noexcept
+    {
+        jassert (sampleRate > 0.0 && frequency > 0.0 && frequency <= sampleRate * 0.5 && q > 0.0);
+
+        const double A = std::sqrt (juce::jmax (0.0, gainFactor));
+        const double omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        const double alpha = std::sin (omega) / (q * 2.0);
+        const double c2 = -2.0 * std::cos (omega);
+        const double alphaTimesA = alpha * A;
+        const double alphaOverA = alpha / A;
+
+        return normalise (1.0 + alphaTimesA, c2, 1.0 - alphaTimesA,
+                          1.0 + alphaOverA, c2, 1.0 - alphaOverA);
+    }
+
+    inline BiquadCoefficients makeLowShelf (double sampleRate, double frequency,
+                                            double q, double gainFactor) noexcept
+    {
+        jassert (sampleRate > 0.0 && frequency > 0.0 && frequency <= sampleRate * 0.5 && q > 0.0);
+
+        const double A = std::sqrt (juce::jmax (0.0, gainFactor));
+        const double aminus1 = A - 1.0;
+        const double aplus1 = A + 1.0;
+        const double omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        const double coso = std::cos (omega);
+        const double beta = std::sin (omega) * std::sqrt (A) / q;
+        const double aminus1TimesCoso = aminus1 * coso;
+
+        return normalise (A * (aplus1 - aminus1TimesCoso + beta),
+                          A * 2.0 * (aminus1 - aplus1 * coso),
+                          A * (aplus1 - aminus1TimesCoso - beta),
+                          aplus1 + aminus1TimesCoso + beta,
+                          -2.0 * (aminus1 + aplus1 * coso),
+                          aplus1 + aminus1TimesCoso - beta);
+    }
+}
@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    Block-rate parameter smoother.
+    Same fixed-length linear or multiplicative ramps as juce::SmoothedValue,
+    but advanced a whole block at a time. At its target (nearly always)
+    process() returns nullptr and costs nothing per sample, so the caller can
+    use getCurrentValue() as a scalar. While ramping, the values are written
+    into a buffer allocated in prepare():
+        linear          current + step * (i + 1), no loop-carried dependency
+        multiplicative  4 values by recurrence, then x[i] = x[i - 4] * step^4
+    Both vectorise. Multiplicative ramps need current and target to be
+    non-zero with the same sign (e.g. linear gains).
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+template <typename SmoothingType = juce::ValueSmoothingTypes::Linear>
+class BlockSmoother
+{
+public:
+    BlockSmoother (float initialValue = 0.0f) noexcept
+        : current (initialValue), target (initialValue) {}
+
+    // Allocates the ramp buffer and jumps to the target, like SmoothedValue::reset()
+    void prepare (double sampleRate, double rampLengthSeconds, int maxBlockSize)
+    {
+        rampSteps = (int) std::floor (rampLengthSeconds * sampleRate);
+        ramp.assign ((size_t) juce::jmax (1, maxBlockSize), 0.0f);
+        setCurrentAndTargetValue (target);
+    }
+
+    void setCurrentAndTargetValue (float newValue) noexcept
+    {
+        current = target = newValue;
+        countdown = 0;
+    }
+
+    void setTargetValue (float newTarget) noexcept
+    {
+        if (newTarget == target)
+            return;
+
+        if (rampSteps <= 0)
+        {
+            setCurrentAndTargetValue (newTarget);
+            return;
+        }
+
+        target = newTarget;
+        countdown = rampSteps;
+
+        if constexpr (isMultiplicative)
+        {
+            jassert (current != 0.0f && target != 0.0f && (current > 0.0f) == (target > 0.0f));
+            step = std::exp ((std::log (std::abs (target)) - std::log (std::abs (current))) / (float) countdown);
+        }
+        else
+        {
+            step = (target - current) / (float) countdown;
+        }
+    }
+
+    float getCurrentValue() const noexcept       { return current; }
+    float getTargetValue() const noexcept        { return target; }
+    bool isSmoothing() const noexcept            { return countdown > 0; }
+
+    // Advances by numSamples (at most the prepared block size). Returns nullptr
+    // when steady - getCurrentValue() then holds for the whole block - or the
+    // numSamples values of the ramp.
+    const float* process (int numSamples) noexcept
+    {
+        if (countdown <= 0)
+            return nullptr;
+
+        fill (ramp.data(), numSamples);
+        return ramp.data();
+    }
+
+    // Like process(), but also fills the buffer when steady. For callers that
+    // combine this value with one that is ramping.
+    const float* processRamp (int numSamples) noexcept
+    {
+        fill (ramp.data(), numSamples);
+        return ramp.data();
+    }
+
+    // Writes the next numSamples values to dest (any size)
+    void fill (float* dest, int numSamples) noexcept
+    {
+        const int numRamp = juce::jmin (numSamples, countdown);
+
+        if (numRamp > 0)
+            generate (dest, numRamp);
+
+        if (numSamples > numRamp)
+            juce::FloatVectorOperations::fill (dest + numRamp, current, numSamples - numRamp);
+    }
+
+    void skip (int numSamples) noexcept
+    {
+        const int numRamp = juce::jmin (numSamples, countdown);
+
+        if (numRamp > 0)
+            advance (numRamp);
+    }
+
+private:
+    static constexpr bool isMultiplicative = std::is_same_v<SmoothingType, juce::ValueSmoothingTypes::Multiplicative>;
+
+    void generate (float* dest, int numRamp) noexcept
+    {
+        if constexpr (isMultiplicative)
+        {
+            float value = current;
+
+            for (int i = 0; i < juce::jmin (numRamp, 4); ++i)
+                dest[i] = value *= step;
+
+            const float step4 = (step * step) * (step * step);
+
+            for (int i = 4; i < numRamp; ++i)
+                dest[i] = dest[i - 4] * step4;
+        }
+        else
+        {
+            for (int i = 0; i < numRamp; ++i)
+                dest[i] = current + step * (float) (i + 1);
+        }
+
+        advance (numRamp);
+
+        // The ramp's last value is exactly the target, as with SmoothedValue
+        if (countdown == 0)
+            dest[numRamp - 1] = target;
+    }
+
+    void advance (int numRamp) noexcept
+    {
+        countdown -= numRamp;
+
+        if (countdown <= 0)
+            current = target;
+        else if constexpr (isMultiplicative)
+            current *= std::pow (step, (float) numRamp);
+        else
+            current += step * (float) numRamp;
+    }
+
+    std::vector<float> ramp;
+    float current = 0.0f, target = 0.0f, step = 0.0f;
+    int countdown = 0, rampSteps = 0;
+};
@@ -0,0 +1,482 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+  ==============================================================================
+*/
+
+#include "EchoStage.h"
+#include "FastMath.h"
+
+void EchoStage::prepare (const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = (float) spec.sampleRate;
+    preparedDivider = rateDivider;
+
+    const int maxBlock = (int) juce::jmax (1u, spec.maximumBlockSize);
+    interleaved.prepare (maxBlock);
+    modOscillator.prepare (maxBlock);
+    modOscillator.setFrequency (0, 0.6f, spec.sampleRate);
+
+    for (auto* v : { &feedbackRamp, &wetGainRamp, &modRamp, &inputL, &inputR, &tapsL, &tapsR })
+        v->assign ((size_t) maxBlock, 0.0f);
+
+    resampler.prepare (preparedDivider, maxBlock);
+    const int maxLoopBlock = resampler.getMaxInternalSamples (maxBlock);
+    loopInterleaved.prepare (maxLoopBlock);
+
+    for (auto* v : { &loopInL, &loopInR, &loopFeedback, &loopGate, &loopTapsL, &loopTapsR,
+                     &writeL, &writeR, &readL, &readR })
+        v->assign ((size_t) maxLoopBlock, 0.0f);
+
+    // Loop-rate copies of the tap ramps are only needed by the vintage engines
+    for (int k = 0; k < maxTaps; ++k)
+    {
+        auto& host = tapRamps[(size_t) k];
+        auto& loop = loopTapRamps[(size_t) k];
+
+        for (auto* v : { &host.delayL, &host.delayR, &host.gainL, &host.gainR })
+            v->assign ((size_t) maxBlock, 0.0f);
+
+        for (auto* v : { &loop.delayL, &loop.delayR, &loop.gainL, &loop.gainR })
+            v->assign (preparedDivider > 1 ? (size_t) maxLoopBlock : 0, 0.0f);
+    }
+
+    // Sized for the longest time plus wobble at the loop rate (interpolation margin is the buffer's job)
+    const double loopRate = spec.sampleRate / preparedDivider;
+    const int maxDelaySamples = (int) std::ceil ((maxDelayTimeMs + modDepthMs) * 0.001 * loopRate) + 1;
+    delayBuffer.prepare (maxDelaySamples, maxLoopBlock, storage);
+
+    updateTapGains();
+
+    for (auto& tap : taps)
+    {
+        tap.time.prepare (spec.sampleRate, 0.1, maxBlock);  // Longer for pitch stability
+        tap.gain.prepare (spec.sampleRate, 0.02, maxBlock);
+        tap.pan.prepare (spec.sampleRate, 0.02, maxBlock);
+    }
+
+    feedbackSmoothed.prepare (spec.sampleRate, 0.02, maxBlock);
+    mixSmoothed.prepare (spec.sampleRate, 0.02, maxBlock);
+    bypassMix.prepare (spec.sampleRate, 0.05, maxBlock);
+    reset();
+}
+
+void EchoStage::reset()
+{
+    delayBuffer.reset();
+    feedbackFilters.reset();
+    resampler.reset();
+}
+
+void EchoStage::setEnabled (bool shouldBeEnabled, bool immediately)
+{
+    if (immediately)
+        bypassMix.setCurrentAndTargetValue (shouldBeEnabled ? 1.0f : 0.0f);
+    else
+        bypassMix.setTargetValue (shouldBeEnabled ? 1.0f : 0.0f);
+}
+
+void EchoStage::setNumTaps (int newNumTaps) noexcept
+{
+    newNumTaps = juce::jlimit (1, maxTaps, newNumTaps);
+
+    if (newNumTaps != numTaps)
+    {
+        numTaps = newNumTaps;
+        updateTapGains();
+    }
+}
+
+void EchoStage::setTapLevel (int index, float level01) noexcept
+{
+    auto& tap = taps[(size_t) index];
+
+    if (level01 != tap.level)
+    {
+        tap.level = level01;
+        updateTapGains();
+    }
+}
+
+void EchoStage::updateTapGains() noexcept
+{
+    for (int k = 0; k < maxTaps; ++k)
+        taps[(size_t) k].gain.setTargetValue (k < numTaps ? taps[(size_t) k].level : 0.0f);
+}
+
+int EchoStage::getNumLiveTaps() const noexcept
+{
+    // Tap 0 always runs (it sets the loop length), the rest until they have faded out
+    int numLive = 1;
+
+    for (int k = 1; k < maxTaps; ++k)
+        if (taps[(size_t) k].isLive())
+            numLive = k + 1;
+
+    return numLive;
+}
+
+double EchoStage::getTailSeconds() const noexcept
+{
+    if ((! bypassMix.isSmoothing() && bypassMix.getCurrentValue() <= 0.001f)
+     || (! mixSmoothed.isSmoothing() && mixSmoothed.getCurrentValue() <= 0.001f))
+        return 0.0;
+
+    // Every longest-tap period the signal goes round the loop at least once,
+    // scaled by at most the feedback (the tap sum is normalised in
+    // processChunk); the filters only take more away. Settings mid-ramp
+    // count at whichever end is longer.
+    const int numLiveTaps = getNumLiveTaps();
+    float longestMs = 0.0f, tapGainSum = 0.0f;
+
+    for (int k = 0; k < numLiveTaps; ++k)
+    {
+        const auto& tap = taps[(size_t) k];
+        longestMs = juce::jmax (longestMs, tap.time.getCurrentValue(), tap.time.getTargetValue());
+        tapGainSum += juce::jmax (tap.gain.getCurrentValue(), tap.gain.getTargetValue());
+    }
+
+    const float feedback = juce::jmax (feedbackSmoothed.getCurrentValue(), feedbackSmoothed.getTargetValue());
+    const double loopGain = (double) feedback * juce::jmin (1.0f, tapGainSum);
+
+    const double repeats = loopGain > 1.0e-6 ? std::ceil (std::log ((double) StageActivity::silenceThreshold) / std::log (loopGain))
+                                             : 0.0;
+
+    return (longestMs + modDepthMs) * 0.001 * (1.0 + repeats);
+}
+
+void EchoStage::setCoefficients (const DelayFeedbackCoefficients& c) noexcept
+{
+    feedbackFilters.setSection (0, c.hiCut);
+    feedbackFilters.setSection (1, c.loCut);
+    feedbackFilters.setSection (2, c.damping);
+}
+
+void EchoStage::process (const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    jassert (block.getNumChannels() >= 2);
+
+    const int numSamples = (int) block.getNumSamples();
+    auto* left = block.getChannelPointer (0);
+    auto* right = block.getChannelPointer (1);
+
+    // Bypassed or no wet signal for the whole block:
+    // still push silence so nothing stale is heard when re-enabled
+    if ((! bypassMix.isSmoothing() && bypassMix.getCurrentValue() <= 0.001f)
+     || (! mixSmoothed.isSmoothing() && mixSmoothed.getCurrentValue() <= 0.001f))
+    {
+        for (auto& tap : taps)
+        {
+            tap.time.skip (numSamples);
+            tap.gain.skip (numSamples);
+            tap.pan.skip (numSamples);
+        }
+
+        feedbackSmoothed.skip (numSamples);
+        mixSmoothed.skip (numSamples);
+        bypassMix.skip (numSamples);
+
+        // Exactly the loop samples the decimator would have produced, so the
+        // write head and the decimator phase stay in step with real time
+        delayBuffer.writeSilence (resampler.skipSilence (numSamples));
+        activity.reset();
+        asleep = false;
+        return;
+    }
+
+    // Silent input and the repeats have died away: the buffer is left as it
+    // is (below the silence threshold) until signal comes back
+    asleep = activity.isIdle (block, [this] { return getTailSeconds() * sampleRate; });
+
+    if (asleep)
+    {
+        for (auto& tap : taps)
+        {
+            tap.time.skip (numSamples);
+            tap.gain.skip (numSamples);
+            tap.pan.skip (numSamples);
+        }
+
+        feedbackSmoothed.skip (numSamples);
+        mixSmoothed.skip (numSamples);
+        bypassMix.skip (numSamples);
+        return;
+    }
+
+    for (int start = 0; start < numSamples;)
+    {
+        // Shortest loop-rate delay any live tap's smoother and the wobble can reach over this chunk.
+        // A chunk of n host samples becomes at most n / divider + 1 loop samples.
+        const int numLiveTaps = getNumLiveTaps();
+        float minDelayMs = maxDelayTimeMs;
+
+        for (int k = 0; k < numLiveTaps; ++k)
+        {
+            const auto& time = taps[(size_t) k].time;
+            minDelayMs = juce::jmin (minDelayMs, time.getCurrentValue(), time.getTargetValue());
+        }
+
+        minDelayMs -= modDepthMs;
+        const float minLoopDelay = minDelayMs * 0.001f * sampleRate / (float) preparedDivider;
+        const int maxChunk = preparedDivider * ((int) (minLoopDelay - StereoDelayBuffer::getMinimumDelayForBlock (0)) - 1);
+
+        const int num = juce::jmin (numSamples - start, interleaved.getCapacity(), juce::jmax (1, maxChunk));
+        processChunk (left + start, right + start, num);
+        start += num;
+    }
+}
+
+void EchoStage::processChunk (float* left, float* right, int numSamples) noexcept
+{
+    const float sr = sampleRate;
+    const float modDepthSamples = modDepthMs * sr / 1000.0f;
+
+    // === CONTROL RAMPS (host rate) ===
+    feedbackSmoothed.fill (feedbackRamp.data(), numSamples);
+
+    // Zero wet gain marks samples where the delay is switched off
+    const bool wetGainIsSteady = ! mixSmoothed.isSmoothing() && ! bypassMix.isSmoothing();
+    const auto wetGainFor = [] (float delayMix, float delayActive) noexcept
+    {
+        return delayActive > 0.001f && delayMix > 0.001f ? delayMix * delayActive : 0.0f;
+    };
+
+    if (wetGainIsSteady)
+    {
+        juce::FloatVectorOperations::fill (wetGainRamp.data(),
+                                           wetGainFor (mixSmoothed.getCurrentValue(), bypassMix.getCurrentValue()),
+                                           numSamples);
+    }
+    else
+    {
+        const float* mixRamp = mixSmoothed.processRamp (numSamples);
+        const float* activeRamp = bypassMix.processRamp (numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            wetGainRamp[(size_t) i] = wetGainFor (mixRamp[i], activeRamp[i]);
+    }
+
+    // Subtle modulation for organic feel, shared by all taps
+    modOscillator.process (numSamples);
+    juce::FloatVectorOperations::multiply (modRamp.data(), modOscillator.getSin (0), modDepthSamples, numSamples);
+
+    // TRUE PING-PONG: only the left line takes input (mono), the right
+    // one is fed from the left taps in the loop
+    if (pingPong)
+    {
+        juce::FloatVectorOperations::add (inputL.data(), left, right, numSamples);
+        juce::FloatVectorOperations::multiply (inputL.data(), 0.5f, numSamples);
+        juce::FloatVectorOperations::clear (inputR.data(), numSamples);
+    }
+    else
+    {
+        juce::FloatVectorOperations::copy (inputL.data(), left, numSamples);
+        juce::FloatVectorOperations::copy (inputR.data(), right, numSamples);
+    }
+
+    // === TAP READ POSITIONS + GAINS ===
+    const int numLiveTaps = getNumLiveTaps();
+    bool tapGainsAreSteady = true;
+
+    for (int k = 0; k < maxTaps; ++k)
+    {
+        auto& tap = taps[(size_t) k];
+
+        if (k >= numLiveTaps)
+        {
+            tap.time.skip (numSamples);
+            tap.gain.skip (numSamples);
+            tap.pan.skip (numSamples);
+            continue;
+        }
+
+        auto& ramps = tapRamps[(size_t) k];
+
+        // Read positions: time in samples, wobble +mod on the left and -mod/2 on the right
+        tap.time.fill (ramps.delayL.data(), numSamples);
+        juce::FloatVectorOperations::multiply (ramps.delayL.data(), sr / 1000.0f, numSamples);
+        juce::FloatVectorOperations::copy (ramps.delayR.data(), ramps.delayL.data(), numSamples);
+        juce::FloatVectorOperations::add (ramps.delayL.data(), modRamp.data(), numSamples);
+        juce::FloatVectorOperations::addWithMultiply (ramps.delayR.data(), modRamp.data(), -0.5f, numSamples);
+
+        // Balance law: centre keeps both sides at full level
+        const bool isSteady = ! tap.gain.isSmoothing() && ! tap.pan.isSmoothing();
+        tapGainsAreSteady = tapGainsAreSteady && isSteady;
+
+        if (isSteady)
+        {
+            const float gain = tap.gain.getCurrentValue();
+            const float pan = tap.pan.getCurrentValue();
+            juce::FloatVectorOperations::fill (ramps.gainL.data(), gain * juce::jmin (1.0f, 1.0f - pan), numSamples);
+            juce::FloatVectorOperations::fill (ramps.gainR.data(), gain * juce::jmin (1.0f, 1.0f + pan), numSamples);
+        }
+        else
+        {
+            tap.gain.fill (ramps.gainL.data(), numSamples);
+            tap.pan.fill (ramps.gainR.data(), numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float gain = ramps.gainL[(size_t) i];
+                const float pan = ramps.gainR[(size_t) i];
+                ramps.gainL[(size_t) i] = gain * juce::jmin (1.0f, 1.0f - pan);
+                ramps.gainR[(size_t) i] = gain * juce::jmin (1.0f, 1.0f + pan);
+            }
+        }
+    }
+
+    // Every tap feeds back, so the loop gain is feedback * (sum of tap gains).
+    // Dividing by that sum (when above 1) keeps it under the feedback setting
+    // and its stability cap for any number of taps and levels.
+    if (tapGainsAreSteady)
+    {
+        float gainSum = 0.0f;
+
+        for (int k = 0; k < numLiveTaps; ++k)
+            gainSum += juce::jmax (tapRamps[(size_t) k].gainL[0], tapRamps[(size_t) k].gainR[0]);
+
+        if (gainSum > 1.0f)
+            juce::FloatVectorOperations::multiply (feedbackRamp.data(), 1.0f / gainSum, numSamples);
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float gainSum = 0.0f;
+
+            for (int k = 0; k < numLiveTaps; ++k)
+                gainSum += juce::jmax (tapRamps[(size_t) k].gainL[(size_t) i], tapRamps[(size_t) k].gainR[(size_t) i]);
+
+            if (gainSum > 1.0f)
+                feedbackRamp[(size_t) i] /= gainSum;
+        }
+    }
+
+    if (preparedDivider == 1)
+    {
+        runFeedbackLoop (inputL.data(), inputR.data(), feedbackRamp.data(), wetGainRamp.data(),
+                         tapRamps, numLiveTaps, tapsL.data(), tapsR.data(), numSamples, interleaved);
+    }
+    else
+    {
+        // === VINTAGE: decimate the input, run the loop, interpolate the taps ===
+        const float* in[] = { inputL.data(), inputR.data() };
+        interleaved.pack (in, 2, numSamples);
+        const int numLoop = resampler.decimate (interleaved.get(), numSamples, loopInterleaved.get());
+
+        float* loopIn[] = { loopInL.data(), loopInR.data() };
+        loopInterleaved.unpack (loopIn, 2, numLoop);
+
+        // Controls are smooth, so the nearest host sample is close enough
+        const float invDivider = 1.0f / (float) preparedDivider;
+
+        for (int j = 0; j < numLoop; ++j)
+        {
+            const auto h = (size_t) juce::jmin (j * preparedDivider, numSamples - 1);
+            loopFeedback[(size_t) j] = feedbackRamp[h];
+            loopGate[(size_t) j] = wetGainRamp[h];
+        }
+
+        for (int k = 0; k < numLiveTaps; ++k)
+        {
+            const auto& host = tapRamps[(size_t) k];
+            auto& loop = loopTapRamps[(size_t) k];
+
+            for (int j = 0; j < numLoop; ++j)
+            {
+                const auto h = (size_t) juce::jmin (j * preparedDivider, numSamples - 1);
+                loop.delayL[(size_t) j] = host.delayL[h] * invDivider;
+                loop.delayR[(size_t) j] = host.delayR[h] * invDivider;
+                loop.gainL[(size_t) j] = host.gainL[h];
+                loop.gainR[(size_t) j] = host.gainR[h];
+            }
+        }
+
+        runFeedbackLoop (loopInL.data(), loopInR.data(), loopFeedback.data(), loopGate.data(),
+                         loopTapRamps, numLiveTaps, loopTapsL.data(), loopTapsR.data(),
+                         numLoop, loopInterleaved);
+
+        const float* loopTapChannels[] = { loopTapsL.data(), loopTapsR.data() };
+        float* tapChannels[] = { tapsL.data(), tapsR.data() };
+        loopInterleaved.pack (loopTapChannels, 2, numLoop);
+        resampler.interpolate (loopInterleaved.get(), interleaved.get(), numSamples);
+        interleaved.unpack (tapChannels, 2, numSamples);
+    }
+
+    // === OUTPUT ===
+    // delayMix controls wet amount, delayActive is the bypass crossfade
+    if (wetGainIsSteady)
+    {
+        if (const float wetGain = wetGainRamp[0]; wetGain > 0.0f)
+        {
+            juce::FloatVectorOperations::addWithMultiply (left, tapsL.data(), wetGain, numSamples);
+            juce::FloatVectorOperations::addWithMultiply (right, tapsR.data(), wetGain, numSamples);
+        }
+    }
+    else
+    {
+        juce::FloatVectorOperations::addWithMultiply (left, tapsL.data(), wetGainRamp.data(), numSamples);
+        juce::FloatVectorOperations::addWithMultiply (right, tapsR.data(), wetGainRamp.data(), numSamples);
+    }
+}
+
+void EchoStage::runFeedbackLoop (const float* inL, const float* inR, const float* feedback, const float* gate,
+                                 const std::array<TapRamps, maxTaps>& ramps, int numLiveTaps,
+                                 float* outTapsL, float* outTapsR, int numSamples,
+                                 SIMDInterleavedBuffer& scratch) noexcept
+{
+    // === GATHER + MIX TAPS (every read is older than this chunk) ===
+    for (int k = 0; k < numLiveTaps; ++k)
+    {
+        const auto& r = ramps[(size_t) k];
+        delayBuffer.read (r.delayL.data(), r.delayR.data(), readL.data(), readR.data(), numSamples, k);
+
+        if (k == 0)
+        {
+            juce::FloatVectorOperations::multiply (outTapsL, readL.data(), r.gainL.data(), numSamples);
+            juce::FloatVectorOperations::multiply (outTapsR, readR.data(), r.gainR.data(), numSamples);
+        }
+        else
+        {
+            juce::FloatVectorOperations::addWithMultiply (outTapsL, readL.data(), r.gainL.data(), numSamples);
+            juce::FloatVectorOperations::addWithMultiply (outTapsR, readR.data(), r.gainR.data(), numSamples);
+        }
+    }
+
+    // Filter the feedback (analog-style degradation)
+    const float* tapChannels[] = { outTapsL, outTapsR };
+    float* filtered[] = { outTapsL, outTapsR };
+    scratch.pack (tapChannels, 2, numSamples);
+    feedbackFilters.process (scratch.get(), numSamples);
+    scratch.unpack (filtered, 2, numSamples);
+
+    // Soft saturation in feedback
+    FastMath::softClipBlock (outTapsL, 1.1f, numSamples);
+    FastMath::softClipBlock (outTapsR, 1.1f, numSamples);
+
+    // === WRITE BACK ===
+    if (pingPong)
+        mixFeedback<true> (inL, inR, feedback, gate, outTapsL, outTapsR, numSamples);
+    else
+        mixFeedback<false> (inL, inR, feedback, gate, outTapsL, outTapsR, numSamples);
+
+    delayBuffer.write (writeL.data(), writeR.data(), numSamples);
+}
+
+template <bool PingPong>
+void EchoStage::mixFeedback (const float* inL, const float* inR, const float* feedback, const float* gate,
+                             const float* filteredL, const float* filteredR, int numSamples) noexcept
+{
+    // L->R->L->R alternating: left gets input + feedback from RIGHT,
+    // right gets feedback from LEFT only. Otherwise a standard stereo delay.
+    const float* fromL = PingPong ? filteredR : filteredL;
+    const float* fromR = PingPong ? filteredL : filteredR;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float g = gate[i] > 0.0f ? 1.0f : 0.0f;
+        writeL[(size_t) i] = g * (inL[i] + fromL[i] * feedback[i]);
+        writeR[(size_t) i] = g * (inR[i] + fromR[i] * feedback[i]);
+    }
+}
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    ECHO - H-Delay style delay with proper ping-pong
+    Runs in chunks no longer than the shortest delay in the chunk, so all
+    taps are gathered first and the feedback filters, saturation and the
+    buffer write each run as one block pass.
+
+    Vintage engines (rate divider 2 or 4) keep the whole feedback loop -
+    buffer, filters, saturation - at half or quarter rate. Only the input is
+    decimated and only the taps are interpolated back. The repeat period
+    stays exact; every echo arrives later by the resampler round trip
+    (16 * divider - 1 host samples, ~0.65 / 1.3 ms at 48 kHz), so nothing
+    is reported to the host.
+
+    Multi-tap: up to maxTaps read heads on the one ring buffer. Tap 0 is the
+    main delay. Each tap has its own time, level and pan; the panned taps are
+    summed before the feedback filters, so the filters, saturation and the
+    buffer write run once per chunk whatever the tap count (Space Echo style
+    head mix - the sum is both the wet signal and what is fed back). The
+    feedback is divided by the summed tap levels when they exceed 1, so the
+    loop gain never goes above the feedback setting.
+  ==============================================================================
+*/
+
+#pragma once
+#include "FilterCoefficientEngine.h"
+#include "PolyphaseResampler.h"
+#include "StereoDelayBuffer.h"
+#include "BlockSmoother.h"
+#include "OscillatorBank.h"
+#include "StageActivity.h"
+
+class EchoStage
+{
+public:
+    // Longest delay time the buffer is sized for (before the wobble)
+    static constexpr float maxDelayTimeMs = 2000.0f;
+    static constexpr int maxTaps = 8;
+
+    void prepare (const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    // 1 = full rate, 2 = half, 4 = quarter. Takes effect on the next prepare().
+    void setRateDivider (int newDivider) noexcept            { rateDivider = juce::jlimit (1, 4, newDivider); }
+    int getRateDivider() const noexcept                      { return rateDivider; }
+
+    // Delay buffer sample format. Takes effect on the next prepare().
+    void setStorage (DelayStorage newStorage) noexcept       { storage = newStorage; }
+    DelayStorage getStorage() const noexcept                 { return storage; }
+
+    // Rate the feedback loop runs at, feedback coefficients must be designed for it
+    double getInternalSampleRate() const noexcept            { return (double) sampleRate / preparedDivider; }
+
+    void setDelayTimeMs (float ms)                           { setTapTimeMs (0, ms); }
+
+    // Taps at or above numTaps fade out. Pan is -1 (left) .. +1 (right).
+    void setNumTaps (int newNumTaps) noexcept;
+    void setTapTimeMs (int index, float ms)                  { taps[(size_t) index].time.setTargetValue (ms); }
+    void setTapLevel (int index, float level01) noexcept;
+    void setTapPan (int index, float pan)                    { taps[(size_t) index].pan.setTargetValue (juce::jlimit (-1.0f, 1.0f, pan)); }
+    void setFeedback (float feedback01)                      { feedbackSmoothed.setTargetValue (feedback01); }
+    void setMix (float mix01)                                { mixSmoothed.setTargetValue (mix01); }
+    void setPingPong (bool shouldPingPong) noexcept          { pingPong = shouldPingPong; }
+    void setInterpolation (DelayInterpolation type) noexcept { delayBuffer.setInterpolation (type); }
+    void setEnabled (bool shouldBeEnabled, bool immediately = false);
+
+    void setCoefficients (const DelayFeedbackCoefficients& c) noexcept;
+
+    // Stereo block, processed in place (wet is added to the input)
+    void process (const juce::dsp::AudioBlock<float>& block) noexcept;
+
+    // How long the output keeps ringing once the input stops, for the current
+    // times, levels and feedback
+    double getTailSeconds() const noexcept;
+
+    // True after a block the stage slept through: its input had been silent
+    // for the whole tail, so nothing is left ringing
+    bool isAsleep() const noexcept                           { return asleep; }
+
+private:
+    struct Tap
+    {
+        BlockSmoother<> time { 250.0f };
+        BlockSmoother<> gain;   // level, 0 once the tap is switched off
+        BlockSmoother<> pan;
+        float level = 1.0f;
+
+        bool isLive() const noexcept   { return gain.isSmoothing() || gain.getCurrentValue() > 0.0f; }
+    };
+
+    // Per tap read positions and L/R gains for one chunk
+    struct TapRamps
+    {
+        std::vector<float> delayL, delayR, gainL, gainR;
+    };
+
+    void processChunk (float* left, float* right, int numSamples) noexcept;
+    void updateTapGains() noexcept;
+    int getNumLiveTaps() const noexcept;
+
+    // One pass of the loop at the internal rate: gather and mix the taps,
+    // filter, saturate, write back. gate <= 0 writes silence.
+    void runFeedbackLoop (const float* inL, const float* inR, const float* feedback, const float* gate,
+                          const std::array<TapRamps, maxTaps>& ramps, int numLiveTaps,
+                          float* outTapsL, float* outTapsR, int numSamples,
+                          SIMDInterleavedBuffer& scratch) noexcept;
+
+    // Input + filtered taps * feedback into the write scratch, gate <= 0 writes zeros
+    template <bool PingPong>
+    void mixFeedback (const float* inL, const float* inR, const float* feedback, const float* gate,
+                      const float* filteredL, const float* filteredR, int numSamples) noexcept;
+
+    static constexpr float modDepthMs = 0.3f;
+
+    StereoDelayBuffer delayBuffer;
+
+    // Feedback filters hiCut -> loCut -> damping, L/R in SIMD lanes
+    SIMDBiquadCascade<3> feedbackFilters;
+    SIMDInterleavedBuffer interleaved;
+
+    // Host rate scratch
+    std::vector<float> feedbackRamp, wetGainRamp, modRamp;
+    std::vector<float> inputL, inputR, tapsL, tapsR;
+    std::array<TapRamps, maxTaps> tapRamps;
+
+    // Internal rate scratch (vintage engines only use the first part of these)
+    PolyphaseResampler resampler;
+    SIMDInterleavedBuffer loopInterleaved;
+    std::vector<float> loopInL, loopInR, loopFeedback, loopGate;
+    std::vector<float> loopTapsL, loopTapsR, writeL, writeR, readL, readR;
+    std::array<TapRamps, maxTaps> loopTapRamps;
+
+    int rateDivider = 1;
+    int preparedDivider = 1;
+    DelayStorage storage = DelayStorage::float32;
+
+    std::array<Tap, maxTaps> taps;
+    int numTaps = 1;
+
+    BlockSmoother<> feedbackSmoothed;
+    BlockSmoother<> mixSmoothed;
+    BlockSmoother<> bypassMix;
+
+    OscillatorBank<1> modOscillator;   // 0.6 Hz wobble
+    StageActivity activity;
+    bool asleep = false;
+    float sampleRate = 44100.0f;
+    bool pingPong = false;
+};
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    Fast tanh / soft-clip approximations.
+
+    tanh()        7/6 Pade (Lambert continued fraction), input clamped to
+                  +-4.97 where it reaches 1.
+                  Max abs error vs std::tanh over the whole real line: 9.6e-5
+                  (the worst case is right at the clamp, below |x| = 3 the
+                  error is under 1e-6).
+
+    tanhCoarse()  5/4 Pade, input clamped to +-3.6.
+                  Max abs error: 1.3e-3. Fine for feedback paths where the
+                  result gets filtered again.
+
+    Both are odd, bounded to [-1, 1], monotonic (tanh() only up to float
+    rounding: for |x| above 3.9 consecutive outputs can dip by up to 6 ulp,
+    3.6e-7) and have unit slope at 0. Past the clamp both are exactly flat.
+    Tests/Source/FastMathTests.cpp checks all of this over +-10.
+    The block versions clamp with FloatVectorOperations::clip and keep the
+    rational part branch-free, so every pass is vectorised.
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace FastMath
+{
+    // Unclamped rational parts, only valid inside the clamp ranges below
+    inline float pade76 (float x) noexcept
+    {
+        const float x2 = x * x;
+        const float num = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+        const float den = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+        return num / den;
+    }
+
+    inline float pade54 (float x) noexcept
+    {
+        const float x2 = x * x;
+        const float num = x * (945.0f + x2 * (105.0f + x2));
+        const float den = 945.0f + x2 * (420.0f + x2 * 15.0f);
+        return num / den;
+    }
+
+    static constexpr float tanhInputLimit = 4.97f;
+    static constexpr float tanhCoarseInputLimit = 3.6f;
+
+    inline float tanh (float x) noexcept
+    {
+        x = juce::jlimit (-tanhInputLimit, tanhInputLimit, x);
+        return juce::jlimit (-1.0f, 1.0f, pade76 (x));
+    }
+
+    inline float tanhCoarse (float x) noexcept
+    {
+        x = juce::jlimit (-tanhCoarseInputLimit, tanhCoarseInputLimit, x);
+        return juce::jlimit (-1.0f, 1.0f, pade54 (x));
+    }
+
+    // tanh (x * drive) / drive - unity gain for small signals, ceiling at 1 / drive
+    inline float softClip (float x, float drive) noexcept
+    {
+        return tanh (x * drive) / drive;
+    }
+
+    inline float softClipCoarse (float x, float drive) noexcept
+    {
+        return tanhCoarse (x * drive) / drive;
+    }
+
+    //==============================================================================
+    inline void tanhBlock (float* data, int numSamples) noexcept
+    {
+        juce::FloatVectorOperations::clip (data, data, -tanhInputLimit, tanhInputLimit, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = pade76 (data[i]);
+
+        juce::FloatVectorOperations::clip (data, data, -1.0f, 1.0f, numSamples);
+    }
+
+    inline void softClipBlock (float* data, float drive, int numSamples) noexcept
+    {
+        const float invDrive = 1.0f / drive;
+
+        juce::FloatVectorOperations::multiply (data, drive, numSamples);
+        tanhBlock (data, numSamples);
+        juce::FloatVectorOperations::multiply (data, invDrive, numSamples);
+    }
+}
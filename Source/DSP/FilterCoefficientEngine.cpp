@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+  ==============================================================================
+*/
+
+#include "FilterCoefficientEngine.h"
+
+void FilterCoefficientEngine::prepare()
+{
+    lastEchoSampleRate = 0.0;
+}
+
+PhoneFilterCoefficients FilterCoefficientEngine::designPhone (int phoneMode, float phoneAmount, double sampleRate) noexcept
+{
+    PhoneFilterCoefficients phone;
+    float phoneIntensity = phoneAmount;
+
+    // WARM phone filter parameters - less harsh, more musical
+    float hpFreq, lpFreq, midFreq, midQ, midGainDb, warmthGain;
+
+    switch (phoneMode)
+    {
+        case 0: // ROTARY (1920s-1950s) - Warm, lo-fi, carbon mic character
+            hpFreq = 350.0f + phoneIntensity * 250.0f;    // Gentle bass cut (350-600 Hz)
+            lpFreq = 2800.0f - phoneIntensity * 800.0f;   // Rounded highs (2000-2800 Hz)
+            midFreq = 900.0f;                              // Lower, warmer peak
+            midQ = 1.5f + phoneIntensity * 2.0f;          // Moderate resonance (1.5-3.5)
+            midGainDb = 3.0f + phoneIntensity * 5.0f;     // Gentle boost (+3 to +8 dB)
+            warmthGain = 1.5f + phoneIntensity * 1.5f;    // Add low warmth
+            break;
+
+        case 1: // TOUCH-TONE (1960s-1980s) - Clear but band-limited
+            hpFreq = 280.0f + phoneIntensity * 120.0f;    // Light bass cut (280-400 Hz)
+            lpFreq = 3600.0f - phoneIntensity * 600.0f;   // Clearer highs (3000-3600 Hz)
+            midFreq = 1400.0f;                             // Presence
+            midQ = 1.2f + phoneIntensity * 1.0f;          // Gentle (1.2-2.2)
+            midGainDb = 2.0f + phoneIntensity * 3.0f;     // Subtle (+2 to +5 dB)
+            warmthGain = 1.2f + phoneIntensity * 0.8f;    // Slight warmth
+            break;
+
+        case 2: // MOBILE (1990s-2000s) - Digital but musical, not harsh
+            hpFreq = 200.0f + phoneIntensity * 200.0f;    // Moderate bass (200-400 Hz)
+            lpFreq = 4200.0f - phoneIntensity * 1000.0f;  // More bandwidth (3200-4200 Hz)
+            midFreq = 2000.0f;                             // Higher presence
+            midQ = 2.0f + phoneIntensity * 2.5f;          // Tighter (2.0-4.5)
+            midGainDb = 3.0f + phoneIntensity * 4.0f;     // Moderate (+3 to +7 dB)
+            warmthGain = 1.0f + phoneIntensity * 0.5f;    // Less warmth (digital)
+            break;
+
+        default:
+            hpFreq = 300.0f; lpFreq = 3400.0f; midFreq = 1200.0f; midQ = 1.5f;
+            midGainDb = 3.0f; warmthGain = 1.2f;
+    }
+
+    // Gentler slopes
+    float hpQ = 0.5f + phoneIntensity * 0.3f;
+    float lpQ = 0.5f + phoneIntensity * 0.3f;
+
+    phone.highpass = SVFDesign::makeHighPass (sampleRate, hpFreq, hpQ);
+    phone.lowpass = SVFDesign::makeLowPass (sampleRate, lpFreq, lpQ);
+    phone.midBoost = SVFDesign::makePeakFilter (sampleRate, midFreq, midQ,
+                                                juce::Decibels::decibelsToGain (midGainDb));
+
+    // Warmth: low shelf boost
+    phone.warmth = SVFDesign::makeLowShelf (sampleRate, 300.0, 0.7, warmthGain);
+
+    // Post filter: gentle smoothing to remove harshness
+    phone.postFilter = SVFDesign::makeLowPass (sampleRate, lpFreq * 1.1f, 0.5);
+
+    return phone;
+}
+
+UnderwaterFilterCoefficients FilterCoefficientEngine::designUnderwater (float underwaterAmount, double sampleRate) noexcept
+{
+    UnderwaterFilterCoefficients underwater;
+    float uwIntensity = underwaterAmount;
+    float uwCutoff = 6000.0f * std::pow (0.08f, uwIntensity);  // Less extreme
+    uwCutoff = std::max (uwCutoff, 300.0f);
+    float uwQ = 0.6f + uwIntensity * 0.8f;  // Gentler resonance
+
+    underwater.main = SVFDesign::makeLowPass (sampleRate, uwCutoff, uwQ);
+
+    // Resonance for "bubble" character
+    float resFreq = uwCutoff * 0.7f;
+    float resQ = 1.0f + uwIntensity * 1.5f;
+    float resGain = juce::Decibels::decibelsToGain (2.0f * uwIntensity);
+    underwater.resonance = SVFDesign::makePeakFilter (sampleRate, resFreq, resQ, resGain);
+
+    // Warmth shelf
+    float uwWarmthGain = 1.0f + uwIntensity * 0.8f;
+    underwater.warmth = SVFDesign::makeLowShelf (sampleRate, 400.0, 0.6, uwWarmthGain);
+
+    return underwater;
+}
+
+bool FilterCoefficientEngine::updateDelayFeedback (double echoSampleRate)
+{
+    if (echoSampleRate == lastEchoSampleRate)
+        return false;
+
+    lastEchoSampleRate = echoSampleRate;
+
+    // Delay feedback filters - warm analog-style rolloff (fixed per sample rate).
+    // The hi-cut stays below Nyquist when the echo runs at a quarter rate.
+    const double hiCutFreq = juce::jmin (4500.0, echoSampleRate * 0.45);
+    delayFeedback.hiCut = BiquadDesign::makeLowPass (echoSampleRate, hiCutFreq, 0.6);
+    delayFeedback.loCut = BiquadDesign::makeHighPass (echoSampleRate, 80.0, 0.7);
+    delayFeedback.damping = BiquadDesign::makeLowShelf (echoSampleRate, 1000.0, 0.7, 0.85);
+
+    return true;
+}
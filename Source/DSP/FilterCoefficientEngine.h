@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    Coefficient design for the stage filters.
+    Phone and underwater are pure functions of (mode, amount, rate) into SVF
+    sections that can be interpolated. The stages don't call them on the
+    audio thread; they read them from FilterCoefficientTables. The fixed delay feedback chain is
+    change-driven and only redesigned when the echo's rate moved.
+  ==============================================================================
+*/
+
+#pragma once
+#include "BiquadDesign.h"
+#include "SVFDesign.h"
+
+struct PhoneFilterCoefficients
+{
+    SVFCoefficients highpass, midBoost, warmth, lowpass, postFilter;
+
+    static PhoneFilterCoefficients interpolate (const PhoneFilterCoefficients& a,
+                                                const PhoneFilterCoefficients& b, float t) noexcept
+    {
+        return { SVFDesign::interpolate (a.highpass, b.highpass, t),
+                 SVFDesign::interpolate (a.midBoost, b.midBoost, t),
+                 SVFDesign::interpolate (a.warmth, b.warmth, t),
+                 SVFDesign::interpolate (a.lowpass, b.lowpass, t),
+                 SVFDesign::interpolate (a.postFilter, b.postFilter, t) };
+    }
+};
+
+struct UnderwaterFilterCoefficients
+{
+    SVFCoefficients main, resonance, warmth;
+
+    static UnderwaterFilterCoefficients interpolate (const UnderwaterFilterCoefficients& a,
+                                                     const UnderwaterFilterCoefficients& b, float t) noexcept
+    {
+        return { SVFDesign::interpolate (a.main, b.main, t),
+                 SVFDesign::interpolate (a.resonance, b.resonance, t),
+                 SVFDesign::interpolate (a.warmth, b.warmth, t) };
+    }
+};
+
+struct DelayFeedbackCoefficients
+{
+    BiquadCoefficients hiCut, loCut, damping;
+};
+
+class FilterCoefficientEngine
+{
+public:
+    // Allocation-free, but pow/tan heavy: tabulated by FilterCoefficientTables
+    static PhoneFilterCoefficients designPhone (int phoneMode, float phoneAmount, double sampleRate) noexcept;
+    static UnderwaterFilterCoefficients designUnderwater (float underwaterAmount, double sampleRate) noexcept;
+
+    // Invalidates the delay feedback design, the next update always redesigns
+    void prepare();
+
+    // Returns true when the coefficients were recomputed
+    bool updateDelayFeedback (double echoSampleRate);   // the echo may run decimated
+
+    const DelayFeedbackCoefficients& getDelayFeedback() const noexcept  { return delayFeedback; }
+
+private:
+    DelayFeedbackCoefficients delayFeedback;
+
+    double lastEchoSampleRate = 0.0;   // sentinel forces the first design
+};
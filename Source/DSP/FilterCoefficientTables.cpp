@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+  ==============================================================================
+*/
+
+#include "FilterCoefficientTables.h"
+
+template <typename Table, typename Build>
+std::shared_ptr<const Table> FilterCoefficientTables::findOrBuild (std::vector<std::weak_ptr<const Table>>& tables,
+                                                                   double sampleRate, Build&& build)
+{
+    // Drop tables nobody uses any more, then look for this rate
+    tables.erase (std::remove_if (tables.begin(), tables.end(),
+                                  [] (const auto& t) { return t.expired(); }),
+                  tables.end());
+
+    for (auto& weak : tables)
+        if (auto table = weak.lock())
+            if (table->getSampleRate() == sampleRate)
+                return table;
+
+    auto table = std::shared_ptr<const Table> (build());
+    tables.push_back (table);
+    return table;
+}
+
+std::shared_ptr<const FilterCoefficientTables::PhoneTable> FilterCoefficientTables::getPhone (double sampleRate)
+{
+    const juce::ScopedLock sl (lock);
+
+    return findOrBuild (phoneTables, sampleRate, [sampleRate]
+    {
+        return new PhoneTable (sampleRate, numPhoneModes, [sampleRate] (int mode, float amount)
+        {
+            return FilterCoefficientEngine::designPhone (mode, amount, sampleRate);
+        });
+    });
+}
+
+std::shared_ptr<const FilterCoefficientTables::UnderwaterTable> FilterCoefficientTables::getUnderwater (double sampleRate)
+{
+    const juce::ScopedLock sl (lock);
+
+    return findOrBuild (underwaterTables, sampleRate, [sampleRate]
+    {
+        return new UnderwaterTable (sampleRate, 1, [sampleRate] (int, float amount)
+        {
+            return FilterCoefficientEngine::designUnderwater (amount, sampleRate);
+        });
+    });
+}
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    Precomputed phone and underwater coefficients.
+    Both designs depend only on (mode, amount, rate), so they are tabulated
+    over the knobs' 1 % grid once per sample rate and read back with linear
+    interpolation between neighbouring entries - the audio thread never
+    runs pow, tan or decibelsToGain. FilterCoefficientTables is shared by
+    every plugin instance through juce::SharedResourcePointer and hands out
+    one read-only table per rate, built on first use in prepare() and freed
+    with the last instance that uses it.
+  ==============================================================================
+*/
+
+#pragma once
+#include "FilterCoefficientEngine.h"
+
+template <typename Coefficients>
+class CoefficientTable
+{
+public:
+    static constexpr int numAmountSteps = 101;   // amount 0..1 in 1 % steps
+
+    // design (mode, amount01) is called for every grid point
+    template <typename DesignFunction>
+    CoefficientTable (double rate, int modes, DesignFunction&& design)
+        : sampleRate (rate), numModes (modes)
+    {
+        entries.reserve ((size_t) (numModes * numAmountSteps));
+
+        for (int mode = 0; mode < numModes; ++mode)
+            for (int i = 0; i < numAmountSteps; ++i)
+                entries.push_back (design (mode, (float) i / (float) (numAmountSteps - 1)));
+    }
+
+    double getSampleRate() const noexcept   { return sampleRate; }
+
+    Coefficients lookup (int mode, float amount01) const noexcept
+    {
+        const float pos = juce::jlimit (0.0f, 1.0f, amount01) * (float) (numAmountSteps - 1);
+        const int i = juce::jmin ((int) pos, numAmountSteps - 2);
+        const auto* row = entries.data() + (size_t) (juce::jlimit (0, numModes - 1, mode) * numAmountSteps);
+
+        return Coefficients::interpolate (row[i], row[i + 1], pos - (float) i);
+    }
+
+private:
+    double sampleRate;
+    int numModes;
+    std::vector<Coefficients> entries;   // numModes rows of numAmountSteps
+
+    JUCE_DECLARE_NON_COPYABLE (CoefficientTable)
+};
+
+//==============================================================================
+class FilterCoefficientTables
+{
+public:
+    using PhoneTable = CoefficientTable<PhoneFilterCoefficients>;
+    using UnderwaterTable = CoefficientTable<UnderwaterFilterCoefficients>;
+
+    static constexpr int numPhoneModes = 3;
+
+    // Called from prepare(): the table for this rate, shared with any other
+    // instance already running at it
+    std::shared_ptr<const PhoneTable> getPhone (double sampleRate);
+    std::shared_ptr<const UnderwaterTable> getUnderwater (double sampleRate);
+
+private:
+    template <typename Table, typename Build>
+    static std::shared_ptr<const Table> findOrBuild (std::vector<std::weak_ptr<const Table>>& tables,
+                                                     double sampleRate, Build&& build);
+
+    juce::CriticalSection lock;
+    std::vector<std::weak_ptr<const PhoneTable>> phoneTables;
+    std::vector<std::weak_ptr<const UnderwaterTable>> underwaterTables;
+};
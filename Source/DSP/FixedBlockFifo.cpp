@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+  ==============================================================================
+*/
+
+#include "FixedBlockFifo.h"
+
+void FixedBlockFifo::prepare (int newBlockSize)
+{
+    blockSize = juce::jmax (1, newBlockSize);
+    buffer.setSize (2, blockSize);
+    reset();
+}
+
+void FixedBlockFifo::reset() noexcept
+{
+    buffer.clear();
+    position = 0;
+}
+
+void DryDelay::prepare (int maxDelaySamples)
+{
+    const int size = juce::nextPowerOfTwo (juce::jmax (1, maxDelaySamples) + 1);
+    historyL.assign ((size_t) size, 0.0f);
+    historyR.assign ((size_t) size, 0.0f);
+    mask = size - 1;
+    writePos = 0;
+}
+
+void DryDelay::reset() noexcept
+{
+    std::fill (historyL.begin(), historyL.end(), 0.0f);
+    std::fill (historyR.begin(), historyR.end(), 0.0f);
+    writePos = 0;
+}
+
+void DryDelay::write (const float* left, const float* right, int numSamples) noexcept
+{
+    // At most two copies per pass (up to the end of the ring, then from 0);
+    // blocks longer than the ring just keep their newest samples
+    for (int start = 0; start < numSamples;)
+    {
+        const int num = juce::jmin (numSamples - start, mask + 1 - writePos);
+        juce::FloatVectorOperations::copy (historyL.data() + writePos, left + start, num);
+
+        if (right != nullptr)
+            juce::FloatVectorOperations::copy (historyR.data() + writePos, right + start, num);
+
+        writePos = (writePos + num) & mask;
+        start += num;
+    }
+}
+
+void DryDelay::process (float* left, float* right, int numSamples, int delaySamples) noexcept
+{
+    jassert (delaySamples >= 0 && delaySamples <= mask);
+
+    // Write before read, so a zero delay passes the input through
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const int readPos = (writePos - delaySamples) & mask;
+        historyL[(size_t) writePos] = left[i];
+        left[i] = historyL[(size_t) readPos];
+
+        if (right != nullptr)
+        {
+            historyR[(size_t) writePos] = right[i];
+            right[i] = historyR[(size_t) readPos];
+        }
+
+        writePos = (writePos + 1) & mask;
+    }
+}
@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    Host-block adapters for the processor.
+    FixedBlockFifo turns whatever block sizes the host sends into whole
+    blocks of one fixed size: each slot hands back the processed sample from
+    the previous block and takes the new input, and a full FIFO is processed
+    in place. The stages then see the same blocks, and the output is the
+    same to the bit, at any host buffer size, for exactly one block of
+    latency.
+
+    DryDelay keeps a history of the dry input so host bypass can output it
+    delayed by the reported latency. It is written while processing runs
+    too, so the delayed dry signal is there the moment bypass engages.
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class FixedBlockFifo
+{
+public:
+    // Always stereo, allocates
+    void prepare (int newBlockSize);
+
+    // Pending samples become silence and the next block starts empty
+    void reset() noexcept;
+
+    int getBlockSize() const noexcept                        { return blockSize; }
+
+    // Swaps the host samples through the FIFO, calling processBlock with an
+    // AudioBlock of the FIFO each time it fills. Mono (right == nullptr):
+    // L feeds both sides, R's output is dropped.
+    template <typename ProcessFunction>
+    void process (float* left, float* right, int numSamples, ProcessFunction&& processBlock) noexcept
+    {
+        auto* fifoL = buffer.getWritePointer (0);
+        auto* fifoR = buffer.getWritePointer (1);
+
+        for (int start = 0; start < numSamples;)
+        {
+            const int num = juce::jmin (numSamples - start, blockSize - position);
+
+            if (right == nullptr)
+                juce::FloatVectorOperations::copy (fifoR + position, left + start, num);
+            else
+                std::swap_ranges (right + start, right + start + num, fifoR + position);
+
+            std::swap_ranges (left + start, left + start + num, fifoL + position);
+
+            start += num;
+            position += num;
+
+            if (position == blockSize)
+            {
+                processBlock (juce::dsp::AudioBlock<float> (buffer));
+                position = 0;
+            }
+        }
+    }
+
+private:
+    juce::AudioBuffer<float> buffer;
+    int blockSize = 0;
+    int position = 0;
+};
+
+class DryDelay
+{
+public:
+    // Allocates a power-of-two ring longer than maxDelaySamples
+    void prepare (int maxDelaySamples);
+    void reset() noexcept;
+
+    int getMaxDelaySamples() const noexcept                  { return mask; }
+
+    // Records the input (right may be nullptr for mono)
+    void write (const float* left, const float* right, int numSamples) noexcept;
+
+    // Records the input and replaces it with the input from delaySamples ago
+    void process (float* left, float* right, int numSamples, int delaySamples) noexcept;
+
+private:
+    std::vector<float> historyL, historyR;
+    int mask = 0;
+    int writePos = 0;
+};
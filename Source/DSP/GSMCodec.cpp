@@ -0,0 +1,378 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+  ==============================================================================
+*/
+
+#include "GSMCodec.h"
+
+namespace
+{
+    // 13-bit codec range, +-1 maps to the 16-bit left aligned full scale
+    constexpr float codecScale = 16384.0f;
+
+    constexpr float offsetAlpha = 32735.0f / 32768.0f;
+    constexpr float emphasisBeta = 28180.0f / 32768.0f;
+
+    // LAR quantisers (6, 6, 5, 5, 4, 4, 3, 3 bits)
+    constexpr float larA[]   = { 20.0f, 20.0f, 20.0f, 20.0f, 13.637f, 15.0f, 8.334f, 8.824f };
+    constexpr float larB[]   = { 0.0f, 0.0f, 4.0f, -5.0f, 0.184f, -3.5f, -0.666f, -2.235f };
+    constexpr int larMin[]   = { -32, -32, -16, -16, -8, -8, -4, -4 };
+    constexpr int larMax[]   = { 31, 31, 15, 15, 7, 7, 3, 3 };
+
+    // LTP gain decision levels and quantised gains
+    constexpr float ltpGainThresholds[] = { 0.2f, 0.5f, 0.8f };
+    constexpr float ltpGains[]          = { 0.1f, 0.35f, 0.65f, 1.0f };
+
+    // RPE weighting filter
+    constexpr float weightingFilter[] = { -134.0f / 8192.0f, -374.0f / 8192.0f, 0.0f, 2054.0f / 8192.0f,
+                                          5741.0f / 8192.0f, 8192.0f / 8192.0f, 5741.0f / 8192.0f,
+                                          2054.0f / 8192.0f, 0.0f, -374.0f / 8192.0f, -134.0f / 8192.0f };
+
+    constexpr int rpeGridSpacing = 3;
+    constexpr int rpePulses = 13;
+
+    // Short-term filter coefficients are interpolated over the first 40 samples
+    constexpr int segmentEnd[]        = { 13, 27, 40, GSMCodec::frameSize };
+    constexpr float segmentPrevious[] = { 0.75f, 0.5f, 0.25f, 0.0f };
+
+    float reflectionToLAR (float r) noexcept
+    {
+        const float a = std::abs (r);
+        const float lar = a < 0.675f ? a : (a < 0.950f ? 2.0f * a - 0.675f : 8.0f * a - 6.375f);
+        return r < 0.0f ? -lar : lar;
+    }
+
+    float larToReflection (float lar) noexcept
+    {
+        const float a = std::abs (lar);
+        const float r = a < 0.675f ? a : (a < 1.225f ? 0.5f * a + 0.3375f : 0.125f * a + 0.796875f);
+        return lar < 0.0f ? -r : r;
+    }
+
+    // 6-bit logarithmic code for the APCM block maximum, and its upper bucket edge
+    int quantiseBlockMaximum (float xmax) noexcept
+    {
+        const int x = juce::jlimit (0, 16383, (int) xmax);
+        int exponent = 0;
+
+        for (int temp = x >> 9; temp > 0 && exponent < 6; temp >>= 1)
+            ++exponent;
+
+        return (x >> (exponent + 5)) + (exponent << 3);
+    }
+
+    float decodeBlockMaximum (int code) noexcept
+    {
+        const int exponent = code < 16 ? 0 : (code >> 3) - 1;
+        const int mantissa = code < 16 ? code : (code & 7) + 8;
+        return (float) (((mantissa + 1) << (exponent + 5)) - 1);
+    }
+}
+
+void GSMCodec::reset() noexcept
+{
+    offsetIn = offsetOut = preEmphasisState = 0.0f;
+    analysisState.fill (0.0f);
+    residualHistory.fill (0.0f);
+    synthesisState.fill (0.0f);
+    deEmphasisState = 0.0f;
+    previousLARpp.fill (0.0f);
+}
+
+void GSMCodec::processFrame (float* frame) noexcept
+{
+    std::array<float, frameSize> s;
+
+    // === PREPROCESSING (offset compensation + pre-emphasis) ===
+    for (int k = 0; k < frameSize; ++k)
+    {
+        const float x = frame[k] * codecScale;
+        const float s1 = x - offsetIn + offsetAlpha * offsetOut;
+        offsetIn = x;
+        offsetOut = s1;
+
+        s[(size_t) k] = s1 - emphasisBeta * preEmphasisState;
+        preEmphasisState = s1;
+    }
+
+    // === LPC ANALYSIS ===
+    std::array<float, lpcOrder> LARpp;
+    computeLARs (s.data(), LARpp.data());
+
+    std::array<std::array<float, lpcOrder>, 4> segmentCoeffs;
+
+    for (size_t seg = 0; seg < 4; ++seg)
+        for (size_t i = 0; i < (size_t) lpcOrder; ++i)
+            segmentCoeffs[seg][i] = larToReflection (segmentPrevious[seg] * previousLARpp[i]
+                                                     + (1.0f - segmentPrevious[seg]) * LARpp[i]);
+
+    previousLARpp = LARpp;
+
+    // === SHORT-TERM ANALYSIS (lattice), s becomes the residual d ===
+    for (size_t seg = 0, k = 0; seg < 4; ++seg)
+    {
+        const auto& rp = segmentCoeffs[seg];
+
+        for (; k < (size_t) segmentEnd[seg]; ++k)
+        {
+            float di = s[k], sav = di;
+
+            for (size_t i = 0; i < (size_t) lpcOrder; ++i)
+            {
+                const float ui = analysisState[i];
+                analysisState[i] = sav;
+                sav = ui + rp[i] * di;
+                di = di + rp[i] * ui;
+            }
+
+            s[k] = di;
+        }
+    }
+
+    // === LTP + RPE per subframe, s becomes the reconstructed residual ===
+    for (int sub = 0; sub < frameSize / subframeSize; ++sub)
+    {
+        std::array<float, subframeSize> ep, dpp;
+        float* d = s.data() + sub * subframeSize;
+
+        encodeSubframe (d, ep.data(), dpp.data());
+
+        for (size_t k = 0; k < (size_t) subframeSize; ++k)
+            d[k] = ep[k] + dpp[k];
+
+        std::copy (residualHistory.begin() + subframeSize, residualHistory.end(), residualHistory.begin());
+        std::copy (d, d + subframeSize, residualHistory.end() - subframeSize);
+    }
+
+    // === DECODER: short-term synthesis + de-emphasis ===
+    for (size_t seg = 0, k = 0; seg < 4; ++seg)
+    {
+        const auto& rp = segmentCoeffs[seg];
+
+        for (; k < (size_t) segmentEnd[seg]; ++k)
+        {
+            float sri = s[k];
+
+            for (int i = lpcOrder - 1; i >= 0; --i)
+            {
+                sri -= rp[(size_t) i] * synthesisState[(size_t) i];
+                synthesisState[(size_t) i + 1] = synthesisState[(size_t) i] + rp[(size_t) i] * sri;
+            }
+
+            synthesisState[0] = sri;
+
+            deEmphasisState = sri + emphasisBeta * deEmphasisState;
+            frame[k] = deEmphasisState / codecScale;
+        }
+    }
+}
+
+void GSMCodec::computeLARs (const float* s, float* LARpp) noexcept
+{
+    // Autocorrelation
+    std::array<float, lpcOrder + 1> acf;
+
+    for (int k = 0; k <= lpcOrder; ++k)
+    {
+        float sum = 0.0f;
+
+        for (int i = k; i < frameSize; ++i)
+            sum += s[i] * s[i - k];
+
+        acf[(size_t) k] = sum;
+    }
+
+    // Schur recursion for the reflection coefficients
+    std::array<float, lpcOrder> r {};
+
+    if (acf[0] > 0.0f)
+    {
+        std::array<float, lpcOrder + 1> P = acf;
+        std::array<float, lpcOrder> K {};
+
+        for (int i = 1; i < lpcOrder; ++i)
+            K[(size_t) i] = acf[(size_t) i];
+
+        for (int n = 1; n <= lpcOrder; ++n)
+        {
+            const float temp = std::abs (P[1]);
+
+            if (P[0] < temp || P[0] <= 0.0f)
+                break;
+
+            float rn = temp / P[0];
+            if (P[1] > 0.0f)
+                rn = -rn;
+
+            r[(size_t) n - 1] = rn;
+
+            if (n == lpcOrder)
+                break;
+
+            P[0] += P[1] * rn;
+
+            for (int m = 1; m <= lpcOrder - n; ++m)
+            {
+                const float pNext = P[(size_t) m + 1];
+                P[(size_t) m] = pNext + K[(size_t) m] * rn;
+                K[(size_t) m] += pNext * rn;
+            }
+        }
+    }
+
+    // Log-area ratios through the transmitted quantisers
+    for (int i = 0; i < lpcOrder; ++i)
+    {
+        const float lar = reflectionToLAR (r[(size_t) i]);
+        const int code = juce::jlimit (larMin[i], larMax[i], juce::roundToInt (larA[i] * lar + larB[i]));
+        LARpp[i] = ((float) code - larB[i]) / larA[i];
+    }
+}
+
+void GSMCodec::encodeSubframe (const float* d, float* ep, float* dpp) noexcept
+{
+    // === LONG-TERM PREDICTION: lag and gain against the reconstructed residual ===
+    const float* history = residualHistory.data() + maxLag;   // history[-lag] is dp[k - lag]
+
+    int bestLag = minLag;
+    float bestCorrelation = -1.0f;
+
+    for (int lag = minLag; lag <= maxLag; ++lag)
+    {
+        float correlation = 0.0f;
+
+        for (int k = 0; k < subframeSize; ++k)
+            correlation += d[k] * history[k - lag];
+
+        if (correlation > bestCorrelation)
+        {
+            bestCorrelation = correlation;
+            bestLag = lag;
+        }
+    }
+
+    float power = 0.0f;
+    for (int k = 0; k < subframeSize; ++k)
+        power += history[k - bestLag] * history[k - bestLag];
+
+    const float gain = (power > 0.0f && bestCorrelation > 0.0f) ? bestCorrelation / power : 0.0f;
+
+    int gainCode = 0;
+    while (gainCode < 3 && gain > ltpGainThresholds[gainCode])
+        ++gainCode;
+
+    std::array<float, subframeSize> e;
+
+    for (int k = 0; k < subframeSize; ++k)
+    {
+        dpp[k] = ltpGains[gainCode] * history[k - bestLag];
+        e[(size_t) k] = d[k] - dpp[k];
+    }
+
+    // === RPE: weighting filter, grid selection, APCM ===
+    std::array<float, subframeSize> x;
+
+    for (int k = 0; k < subframeSize; ++k)
+    {
+        float sum = 0.0f;
+
+        for (int i = 0; i < 11; ++i)
+        {
+            const int idx = k + 5 - i;
+            if (idx >= 0 && idx < subframeSize)
+                sum += weightingFilter[i] * e[(size_t) idx];
+        }
+
+        x[(size_t) k] = sum;
+    }
+
+    int grid = 0;
+    float bestEnergy = -1.0f;
+
+    for (int m = 0; m < 4; ++m)
+    {
+        float energy = 0.0f;
+
+        for (int i = 0; i < rpePulses; ++i)
+            energy += x[(size_t) (m + rpeGridSpacing * i)] * x[(size_t) (m + rpeGridSpacing * i)];
+
+        if (energy > bestEnergy)
+        {
+            bestEnergy = energy;
+            grid = m;
+        }
+    }
+
+    float xmax = 0.0f;
+    for (int i = 0; i < rpePulses; ++i)
+        xmax = juce::jmax (xmax, std::abs (x[(size_t) (grid + rpeGridSpacing * i)]));
+
+    const float xmaxp = decodeBlockMaximum (quantiseBlockMaximum (xmax));
+
+    std::fill (ep, ep + subframeSize, 0.0f);
+
+    for (int i = 0; i < rpePulses; ++i)
+    {
+        // 3-bit uniform quantiser on the normalised pulse, levels (2c - 7) / 8
+        const float normalised = x[(size_t) (grid + rpeGridSpacing * i)] / xmaxp;
+        const int code = juce::jlimit (0, 7, (int) std::floor ((normalised + 1.0f) * 4.0f));
+        ep[grid + rpeGridSpacing * i] = (float) (2 * code - 7) * 0.125f * xmaxp;
+    }
+}
+
+//==============================================================================
+void GSMCodecPath::prepare (double internalSampleRate, int maxInternalSamples)
+{
+    // The frame delay below is part of the round trip the resampler rounds to whole samples
+    narrowRate.prepare (internalSampleRate, GSMCodec::sampleRate, maxInternalSamples,
+                        resamplerTapsPerPhase, GSMCodec::frameSize);
+    narrowBuffer.assign ((size_t) narrowRate.getMaxInternalSamples (maxInternalSamples), SIMDFloat::expand (0.0f));
+    reset();
+}
+
+void GSMCodecPath::reset() noexcept
+{
+    narrowRate.reset();
+
+    for (auto& c : codecs)
+        c.reset();
+
+    for (auto& f : inputFrames)
+        f.fill (0.0f);
+
+    for (auto& f : outputFrames)
+        f.fill (0.0f);
+
+    framePos = 0;
+}
+
+void GSMCodecPath::process (SIMDFloat* data, int numSamples) noexcept
+{
+    const int numNarrow = narrowRate.decimate (data, numSamples, narrowBuffer.data());
+
+    for (int j = 0; j < numNarrow; ++j)
+    {
+        float left, right;
+        unpackStereo (narrowBuffer[(size_t) j], left, right);
+
+        // Output lags the input by exactly one frame
+        narrowBuffer[(size_t) j] = packStereo (outputFrames[0][(size_t) framePos], outputFrames[1][(size_t) framePos]);
+        inputFrames[0][(size_t) framePos] = left;
+        inputFrames[1][(size_t) framePos] = right;
+
+        if (++framePos == GSMCodec::frameSize)
+        {
+            for (size_t ch = 0; ch < 2; ++ch)
+            {
+                outputFrames[ch] = inputFrames[ch];
+                codecs[ch].processFrame (outputFrames[ch].data());
+            }
+
+            framePos = 0;
+        }
+    }
+
+    narrowRate.interpolate (narrowBuffer.data(), data, numSamples);
+}
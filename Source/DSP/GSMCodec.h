@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    GSM 06.10 full-rate (RPE-LTP) codec emulation for the Mobile phone mode.
+
+    GSMCodec runs the encoder and the matching decoder on one 160-sample
+    frame (20 ms at 8 kHz) in floating point. Every parameter the real codec
+    transmits goes through the standard's quantisers: LARs, LTP lag and gain,
+    RPE grid and APCM block maximum / samples. What comes out carries the same
+    coding artefacts, but it is not bit-exact with the ETSI reference.
+
+    GSMCodecPath wraps a stereo pair of codecs for the phone stage. It
+    resamples the phone's internal rate to exactly 8 kHz (a plain 2:1 at
+    48/96/192 kHz hosts, 160:441 from 22.05 kHz, 200:441 from 17.64 kHz),
+    buffers whole frames and resamples back, so frame length, lag range and
+    formants are the same at every host rate. Latency is fixed at
+    getLatencySamples() internal-rate samples (about 24 ms). Nothing
+    allocates after prepare().
+
+    Cost: about 17k multiply-adds per frame and channel, dominated by the
+    LTP lag search, i.e. under 1 M per second per channel at 8 kHz, plus
+    ~1.5 M stereo multiply-adds per second for the resampling.
+    Budget: the whole phone stage in Mobile mode with the codec must stay
+    under 1.5 % of one core per instance (30 tracks in half a core),
+    checked by PhoneCodecBenchmark in Tests/. The codec pair and the
+    resampling add about 0.4 % to the stage.
+  ==============================================================================
+*/
+
+#pragma once
+#include "PolyphaseResampler.h"
+
+class GSMCodec
+{
+public:
+    static constexpr double sampleRate = 8000.0;
+    static constexpr int frameSize = 160;
+    static constexpr int subframeSize = 40;
+
+    GSMCodec() noexcept   { reset(); }
+
+    void reset() noexcept;
+
+    // Encodes and decodes one frame in place, full scale +-1
+    void processFrame (float* frame) noexcept;
+
+private:
+    static constexpr int lpcOrder = 8;
+    static constexpr int minLag = 40, maxLag = 120;
+
+    void computeLARs (const float* s, float* LARpp) noexcept;
+    void encodeSubframe (const float* d, float* ep, float* dpp) noexcept;
+
+    // Encoder state
+    float offsetIn = 0.0f, offsetOut = 0.0f, preEmphasisState = 0.0f;
+    std::array<float, lpcOrder> analysisState {};
+    std::array<float, maxLag> residualHistory {};   // reconstructed short-term residual, oldest first
+
+    // Decoder state
+    std::array<float, lpcOrder + 1> synthesisState {};
+    float deEmphasisState = 0.0f;
+
+    // Decoded LARs of the previous frame, for the interpolation at frame start
+    std::array<float, lpcOrder> previousLARpp {};
+};
+
+//==============================================================================
+class GSMCodecPath
+{
+public:
+    static constexpr int resamplerTapsPerPhase = 32;   // keeps ~3.4 kHz of the 4 kHz band
+
+    void prepare (double internalSampleRate, int maxInternalSamples);
+    void reset() noexcept;
+
+    // Resampling both ways plus one frame, in internal-rate samples
+    int getLatencySamples() const noexcept        { return narrowRate.getLatencySamples(); }
+
+    // In place at the phone's internal rate, L/R in lanes 0 and 1
+    void process (SIMDFloat* data, int numSamples) noexcept;
+
+private:
+    RationalResampler narrowRate;
+    std::vector<SIMDFloat> narrowBuffer;
+
+    std::array<GSMCodec, 2> codecs;
+    std::array<std::array<float, GSMCodec::frameSize>, 2> inputFrames {}, outputFrames {};
+    int framePos = 0;
+};
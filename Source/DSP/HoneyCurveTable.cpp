@@ -0,0 +1,25 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+  ==============================================================================
+*/
+
+#include "HoneyCurveTable.h"
+
+HoneyCurveTable::HoneyCurveTable()
+{
+    table.resize ((size_t) (numDriveSteps * numInputPoints));
+
+    for (int j = 0; j < numDriveSteps; ++j)
+    {
+        const float satAmt = (float) j / (float) (numDriveSteps - 1);
+        auto* row = table.data() + (size_t) j * (size_t) numInputPoints;
+
+        for (int i = 0; i < numInputPoints; ++i)
+        {
+            const double x = -inputRange + (double) i / (double) inputScale;
+            row[i] = (float) HoneyCurves::evaluate (x, satAmt);
+        }
+    }
+}
@@ -0,0 +1,284 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+  ==============================================================================
+*/
+
+#include "HoneyStage.h"
+#include "FastMath.h"
+
+namespace
+{
+    // Input gain, tube, 2nd harmonic, tape and transformer stages (memoryless)
+    inline float honeyShape (float x, float satAmt) noexcept
+    {
+        // Input gain staging
+        x *= 1.0f + satAmt * 1.5f;
+
+        // Stage 1: Tube-style warmth (even harmonics)
+        // Soft asymmetric curve that adds 2nd harmonic
+        float tubeDrive = 0.8f + satAmt * 0.4f;
+        x = x * tubeDrive / (1.0f + std::abs (x * tubeDrive) * 0.3f);
+
+        // Add subtle 2nd harmonic (even)
+        x += std::abs (x) * x * 0.15f * satAmt;
+
+        // Stage 2: Tape-style saturation (odd harmonics, compression)
+        float tapeDrive = 1.0f + satAmt * 0.8f;
+        x = FastMath::softClip (x, tapeDrive);
+
+        // Stage 3: Transformer coloration (subtle)
+        float xfmrAmt = satAmt * 0.3f;
+        return x * (1.0f - xfmrAmt) + FastMath::tanh (x * 1.2f) * xfmrAmt;
+    }
+}
+
+void HoneyStage::prepare (const juce::dsp::ProcessSpec& spec)
+{
+    maxBlockSize = (int) juce::jmax (1u, spec.maximumBlockSize);
+    ringOutSamples = (int) (0.1 * spec.sampleRate);
+
+    for (int i = 0; i < maxOversamplingOrder; ++i)
+    {
+        oversamplers[(size_t) i] = std::make_unique<juce::dsp::Oversampling<float>> (
+            2, (size_t) (i + 1), juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true, true);
+        oversamplers[(size_t) i]->initProcessing ((size_t) maxBlockSize);
+    }
+
+    juce::dsp::ProcessSpec stereoSpec { spec.sampleRate, (juce::uint32) maxBlockSize, 2 };
+    dryDelay.setMaximumDelayInSamples (64);
+    dryDelay.prepare (stereoSpec);
+
+    wetBuffer.setSize (2, maxBlockSize);
+    amountRamp.assign ((size_t) maxBlockSize, 0.0f);
+    mixRamp.assign ((size_t) maxBlockSize, 0.0f);
+
+    amountSmoothed.prepare (spec.sampleRate, 0.02, maxBlockSize);
+    mixSmoothed.prepare (spec.sampleRate, 0.05, maxBlockSize);   // Longer ramp for bypass
+
+    reset();
+    setOversamplingOrder (oversamplingOrder);
+}
+
+void HoneyStage::reset()
+{
+    for (auto& os : oversamplers)
+        if (os != nullptr)
+            os->reset();
+
+    dryDelay.reset();
+    oversamplerIsStale = false;
+    resetAntiAliasing();
+
+    dcInL = dcInR = 0.0f;
+    dcOutL = dcOutR = 0.0f;
+}
+
+void HoneyStage::setEnabled (bool shouldBeEnabled, bool immediately)
+{
+    if (immediately)
+        mixSmoothed.setCurrentAndTargetValue (shouldBeEnabled ? 1.0f : 0.0f);
+    else
+        mixSmoothed.setTargetValue (shouldBeEnabled ? 1.0f : 0.0f);
+}
+
+void HoneyStage::setAntiAliasing (bool shouldUseADAA) noexcept
+{
+    if (shouldUseADAA != useADAA)
+    {
+        useADAA = shouldUseADAA;
+        resetAntiAliasing();
+    }
+}
+
+void HoneyStage::resetAntiAliasing() noexcept
+{
+    for (auto& s : adaa)
+    {
+        s.tube.reset();
+        s.tape.reset();
+        s.xfmr.reset();
+    }
+}
+
+void HoneyStage::setOversamplingOrder (int order) noexcept
+{
+    order = juce::jlimit (0, maxOversamplingOrder, order);
+
+    if (order != oversamplingOrder)
+    {
+        oversamplingOrder = order;
+        oversamplerIsStale = true;
+        dryDelay.reset();
+    }
+
+    auto* os = order > 0 ? oversamplers[(size_t) (order - 1)].get() : nullptr;
+    latencySamples = os != nullptr ? juce::roundToInt (os->getLatencyInSamples()) : 0;
+
+    jassert (latencySamples <= dryDelay.getMaximumDelayInSamples());
+    dryDelay.setDelay ((float) latencySamples);
+}
+
+void HoneyStage::process (const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    jassert (block.getNumChannels() >= 2);
+
+    const int numSamples = (int) block.getNumSamples();
+
+    // Fully bypassed or fully dry for the whole block: only the latency delay
+    if ((! mixSmoothed.isSmoothing() && mixSmoothed.getCurrentValue() <= 0.001f)
+     || (! amountSmoothed.isSmoothing() && amountSmoothed.getCurrentValue() <= 0.001f))
+    {
+        mixSmoothed.skip (numSamples);
+        amountSmoothed.skip (numSamples);
+
+        if (latencySamples > 0)
+        {
+            auto stereo = block.getSubsetChannelBlock (0, 2);
+            dryDelay.process (juce::dsp::ProcessContextReplacing<float> (stereo));
+        }
+
+        oversamplerIsStale = true;
+        activity.reset();
+        return;
+    }
+
+    // Silent for longer than the latency and ring-out: the output is silent too
+    if (activity.isIdle (block, [this] { return latencySamples + ringOutSamples; }))
+    {
+        mixSmoothed.skip (numSamples);
+        amountSmoothed.skip (numSamples);
+        return;
+    }
+
+    if (oversamplerIsStale)
+    {
+        // Don't let old oversampler state leak into the fade-in
+        for (auto& os : oversamplers)
+            os->reset();
+
+        resetAntiAliasing();
+        oversamplerIsStale = false;
+    }
+
+    for (int start = 0; start < numSamples; start += maxBlockSize)
+    {
+        const int num = juce::jmin (numSamples - start, maxBlockSize);
+        processChunk (block.getSubBlock ((size_t) start, (size_t) num));
+    }
+}
+
+void HoneyStage::processChunk (const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    const int numSamples = (int) block.getNumSamples();
+    auto* left = block.getChannelPointer (0);
+    auto* right = block.getChannelPointer (1);
+
+    // Checked before the ramps below move the smoothers
+    const bool isRamping = amountSmoothed.isSmoothing() || mixSmoothed.isSmoothing();
+
+    amountSmoothed.fill (amountRamp.data(), numSamples);
+    mixSmoothed.fill (mixRamp.data(), numSamples);
+
+    // Wet path: copy of the input, shaped (optionally oversampled)
+    juce::dsp::AudioBlock<float> wet (wetBuffer);
+    wet = wet.getSubsetChannelBlock (0, 2).getSubBlock (0, (size_t) numSamples);
+    wet.copyFrom (block.getSubsetChannelBlock (0, 2));
+
+    if (oversamplingOrder > 0)
+    {
+        auto& os = *oversamplers[(size_t) (oversamplingOrder - 1)];
+        auto upBlock = os.processSamplesUp (wet);
+        shapeBlock (upBlock, 1 << oversamplingOrder);
+        os.processSamplesDown (wet);
+
+        // Dry path delayed to line up with the oversampled wet path
+        auto stereo = block.getSubsetChannelBlock (0, 2);
+        dryDelay.process (juce::dsp::ProcessContextReplacing<float> (stereo));
+    }
+    else
+    {
+        shapeBlock (wet, 1);
+    }
+
+    auto* wetL = wet.getChannelPointer (0);
+    auto* wetR = wet.getChannelPointer (1);
+
+    if (isRamping)
+        mixChunk<true> (wetL, wetR, left, right, numSamples);
+    else
+        mixChunk<false> (wetL, wetR, left, right, numSamples);
+}
+
+template <bool IsRamping>
+void HoneyStage::mixChunk (const float* wetL, const float* wetR, float* left, float* right, int numSamples) noexcept
+{
+    // Steady: process() already skipped fully dry blocks, so every sample is wet
+    float satAmt = amountRamp[0];
+    float satMix = mixRamp[0];
+    float makeupGain = 1.0f / (1.0f + satAmt * 0.4f);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // DC blocking (one-pole high-pass, removes the 2nd harmonic offset)
+        const float dcCoeff = 0.995f;
+        float satL = wetL[i] - dcInL + dcCoeff * dcOutL;
+        float satR = wetR[i] - dcInR + dcCoeff * dcOutR;
+        dcInL = wetL[i];  dcOutL = satL;
+        dcInR = wetR[i];  dcOutR = satR;
+
+        if constexpr (IsRamping)
+        {
+            satAmt = amountRamp[(size_t) i];
+            satMix = mixRamp[(size_t) i];
+
+            if (satMix <= 0.001f || satAmt <= 0.001f)
+                continue;
+
+            // Output gain compensation (louder input = less makeup)
+            makeupGain = 1.0f / (1.0f + satAmt * 0.4f);
+        }
+
+        satL *= makeupGain;
+        satR *= makeupGain;
+
+        // Mix with dry based on satMix (bypass crossfade)
+        left[i] = left[i] * (1.0f - satMix) + satL * satMix;
+        right[i] = right[i] * (1.0f - satMix) + satR * satMix;
+    }
+}
+
+void HoneyStage::shapeBlock (const juce::dsp::AudioBlock<float>& block, int ratio) noexcept
+{
+    const int numSamples = (int) block.getNumSamples();
+
+    for (size_t ch = 0; ch < 2; ++ch)
+    {
+        auto* data = block.getChannelPointer (ch);
+
+        // Drive is smoothed at the host rate and held across each oversampled group
+        if (useADAA)
+        {
+            auto& s = adaa[ch];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float satAmt = amountRamp[(size_t) (i / ratio)];
+                float x = s.tube.process (data[i], HoneyCurves::tube (satAmt));
+                x = s.tape.process (x, HoneyCurves::tape (satAmt));
+                data[i] = s.xfmr.process (x, HoneyCurves::xfmr (satAmt));
+            }
+        }
+        else if (useCurveTable)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = curveTable->process (data[i], amountRamp[(size_t) (i / ratio)]);
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = honeyShape (data[i], amountRamp[(size_t) (i / ratio)]);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    HONEY - HG-2 inspired saturation stage
+    Only the memoryless waveshaper runs oversampled (1x/2x/4x/8x, polyphase
+    IIR half-bands). The dry path is delayed by the same amount so the
+    bypass crossfade stays phase aligned and the reported latency does not
+    change when Honey is switched on or off.
+    With anti-aliasing on, every curve runs through first-order ADAA, which
+    works on its own at 1x or stacks with the oversampler.
+    The table mode reads the whole curve from the shared HoneyCurveTable
+    instead; ADAA takes precedence when both are on.
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "HoneyCurveTable.h"
+#include "BlockSmoother.h"
+#include "StageActivity.h"
+
+class HoneyStage
+{
+public:
+    static constexpr int maxOversamplingOrder = 3;   // 2^3 = 8x
+
+    void prepare (const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    void setAmount (float amount01)                          { amountSmoothed.setTargetValue (amount01); }
+    void setEnabled (bool shouldBeEnabled, bool immediately = false);
+
+    // 0 = 1x, 1 = 2x, 2 = 4x, 3 = 8x
+    void setOversamplingOrder (int order) noexcept;
+    int getLatencySamples() const noexcept                   { return latencySamples; }
+    int getMaxLatencySamples() const noexcept                { return dryDelay.getMaximumDelayInSamples(); }
+
+    // First-order ADAA on the tube, tape and transformer curves
+    void setAntiAliasing (bool shouldUseADAA) noexcept;
+
+    // Bilinear lookup of the precomputed curve instead of evaluating it
+    void setUseCurveTable (bool shouldUseTable) noexcept     { useCurveTable = shouldUseTable; }
+
+    // Stereo block, processed in place
+    void process (const juce::dsp::AudioBlock<float>& block) noexcept;
+
+private:
+    void processChunk (const juce::dsp::AudioBlock<float>& block) noexcept;
+
+    // DC blocker, makeup and dry/wet mix; the steady variant has no per-sample checks
+    template <bool IsRamping>
+    void mixChunk (const float* wetL, const float* wetR, float* left, float* right, int numSamples) noexcept;
+    void shapeBlock (const juce::dsp::AudioBlock<float>& block, int ratio) noexcept;
+    void resetAntiAliasing() noexcept;
+
+    std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, maxOversamplingOrder> oversamplers;
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None> dryDelay;
+
+    juce::AudioBuffer<float> wetBuffer;
+    std::vector<float> amountRamp, mixRamp;
+
+    BlockSmoother<> amountSmoothed;
+    BlockSmoother<> mixSmoothed;
+
+    StageActivity activity;
+    int ringOutSamples = 0;   // DC blocker and oversampling filters, on top of the latency
+
+    int oversamplingOrder = 0;
+    int latencySamples = 0;
+    int maxBlockSize = 0;
+    bool oversamplerIsStale = false;
+    bool useADAA = false;
+    bool useCurveTable = false;
+
+    juce::SharedResourcePointer<HoneyCurveTable> curveTable;
+
+    struct ADAAChannel
+    {
+        ADAA1<ADAACurves::TubeHarmonic> tube;
+        ADAA1<ADAACurves::SoftClip> tape;
+        ADAA1<ADAACurves::Transformer> xfmr;
+    };
+
+    std::array<ADAAChannel, 2> adaa;
+
+    // DC blocker state
+    float dcInL = 0.0f, dcInR = 0.0f;
+    float dcOutL = 0.0f, dcOutR = 0.0f;
+};
@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+  ==============================================================================
+*/
+
+#include "HumStage.h"
+
+void HumStage::prepare (const juce::dsp::ProcessSpec& spec)
+{
+    maxBlockSize = (int) juce::jmax (1u, spec.maximumBlockSize);
+
+    oscillators.prepare (maxBlockSize);
+    oscillators.setFrequency (hum, 60.0f, spec.sampleRate);
+    oscillators.setFrequency (flutter, 0.3f, spec.sampleRate);
+    reset();
+}
+
+void HumStage::reset()
+{
+    oscillators.setPhase (hum, 0.0f);
+    oscillators.setPhase (flutter, 0.0f);
+}
+
+void HumStage::process (const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    jassert (block.getNumChannels() >= 2);
+
+    if (! isGenerating())
+        return;
+
+    const int numSamples = (int) block.getNumSamples();
+    auto* left = block.getChannelPointer (0);
+    auto* right = block.getChannelPointer (1);
+
+    for (int start = 0; start < numSamples; start += maxBlockSize)
+    {
+        const int num = juce::jmin (numSamples - start, maxBlockSize);
+        processChunk (left + start, right + start, num);
+    }
+}
+
+void HumStage::processChunk (float* left, float* right, int numSamples) noexcept
+{
+    oscillators.process (numSamples);
+    const float* sin60 = oscillators.getSin (hum);
+    const float* cos60 = oscillators.getCos (hum);
+    const float* sinFlutter = oscillators.getSin (flutter);
+
+    const float level = amount * 0.008f;  // Very subtle - max 0.8% of signal
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // 60Hz fundamental + harmonics for authentic hum
+        // sin 2x = 2 sin x cos x,  sin 3x = sin x (3 - 4 sin^2 x)
+        const float s = sin60[i];
+        float hum60 = s * 0.4f;
+        float hum120 = 2.0f * s * cos60[i] * 0.25f;
+        float hum180 = s * (3.0f - 4.0f * s * s) * 0.1f;
+
+        // Slight random flutter for vintage character
+        float flutterAmt = sinFlutter[i] * 0.15f;
+
+        float humSignal = (hum60 + hum120 + hum180) * (1.0f + flutterAmt) * level;
+
+        left[i] += humSignal;
+        right[i] += humSignal * 0.95f;  // Slight stereo difference
+    }
+}
@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    CABLE HUM - subtle vintage warmth from the easter egg screw
+    One recursive 60 Hz oscillator gives the 120 and 180 Hz harmonics
+    through the multiple-angle identities, so the hum needs no sin calls.
+  ==============================================================================
+*/
+
+#pragma once
+#include "OscillatorBank.h"
+
+class HumStage
+{
+public:
+    void prepare (const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    void setAmount (float amount01) noexcept                 { amount = amount01; }
+
+    // Hum is added whatever the input, so while this is on the output never goes silent
+    bool isGenerating() const noexcept                       { return amount > 0.001f; }
+
+    // Stereo block, hum is added in place
+    void process (const juce::dsp::AudioBlock<float>& block) noexcept;
+
+private:
+    void processChunk (float* left, float* right, int numSamples) noexcept;
+
+    enum { hum, flutter };
+    OscillatorBank<2> oscillators;   // 60 Hz hum, 0.3 Hz flutter
+
+    float amount = 0.0f;
+    int maxBlockSize = 512;
+};
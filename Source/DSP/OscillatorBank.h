@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    Recursive sine/cosine oscillators for LFOs and hum.
+    Each oscillator is a coupled-form (rotation) recursion: the (cos, sin)
+    pair is rotated by the phase increment every sample, so a block of sin
+    and cos costs four multiplies per sample and oscillator instead of a
+    std::sin call. All oscillators in a bank advance in one pass and write
+    whole blocks into buffers allocated in prepare(). Rounding makes the
+    amplitude creep, so it is pulled back to 1 once per block.
+    Frequency changes cost one sin/cos pair and keep the phase.
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+template <int NumOscillators>
+class OscillatorBank
+{
+public:
+    static constexpr int numOscillators = NumOscillators;
+
+    // Phase 0, not moving
+    OscillatorBank() noexcept
+    {
+        c.fill (1.0f);
+        s.fill (0.0f);
+        stepCos.fill (1.0f);
+        stepSin.fill (0.0f);
+    }
+
+    void prepare (int maxBlockSize)
+    {
+        blockSize = juce::jmax (1, maxBlockSize);
+        sinBuffer.assign ((size_t) (NumOscillators * blockSize), 0.0f);
+        cosBuffer.assign ((size_t) (NumOscillators * blockSize), 0.0f);
+    }
+
+    void setFrequency (int index, float frequencyHz, double sampleRate) noexcept
+    {
+        jassert (juce::isPositiveAndBelow (index, NumOscillators) && sampleRate > 0.0);
+        const double w = juce::MathConstants<double>::twoPi * frequencyHz / sampleRate;
+        stepCos[(size_t) index] = (float) std::cos (w);
+        stepSin[(size_t) index] = (float) std::sin (w);
+    }
+
+    void setPhase (int index, float radians) noexcept
+    {
+        jassert (juce::isPositiveAndBelow (index, NumOscillators));
+        c[(size_t) index] = std::cos (radians);
+        s[(size_t) index] = std::sin (radians);
+    }
+
+    // Writes the next numSamples (at most the prepared block size) of every
+    // oscillator, starting at its current phase
+    void process (int numSamples) noexcept
+    {
+        jassert (numSamples <= blockSize);
+
+        for (size_t k = 0; k < (size_t) NumOscillators; ++k)
+        {
+            auto* sinOut = sinBuffer.data() + k * (size_t) blockSize;
+            auto* cosOut = cosBuffer.data() + k * (size_t) blockSize;
+            float ck = c[k], sk = s[k];
+            const float wc = stepCos[k], ws = stepSin[k];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                sinOut[i] = sk;
+                cosOut[i] = ck;
+
+                const float nextC = ck * wc - sk * ws;
+                sk = sk * wc + ck * ws;
+                ck = nextC;
+            }
+
+            // First-order pull back onto the unit circle
+            const float g = 1.5f - 0.5f * (ck * ck + sk * sk);
+            c[k] = ck * g;
+            s[k] = sk * g;
+        }
+    }
+
+    const float* getSin (int index) const noexcept   { return sinBuffer.data() + (size_t) (index * blockSize); }
+    const float* getCos (int index) const noexcept   { return cosBuffer.data() + (size_t) (index * blockSize); }
+
+private:
+    std::array<float, (size_t) NumOscillators> c, s;                 // current cos, sin
+    std::array<float, (size_t) NumOscillators> stepCos, stepSin;     // per-sample rotation
+
+    std::vector<float> sinBuffer, cosBuffer;   // NumOscillators rows of blockSize
+    int blockSize = 0;
+};
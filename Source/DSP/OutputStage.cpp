@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+  ==============================================================================
+*/
+
+#include "OutputStage.h"
+#include "FastMath.h"
+
+void OutputStage::prepare (const juce::dsp::ProcessSpec& spec)
+{
+    maxBlockSize = (int) juce::jmax (1u, spec.maximumBlockSize);
+    gainSmoothed.prepare (spec.sampleRate, 0.02, maxBlockSize);
+    reset();
+}
+
+void OutputStage::reset()
+{
+    for (auto& a : limiterADAA)
+        a.reset();
+}
+
+void OutputStage::setAntiAliasing (bool shouldUseADAA) noexcept
+{
+    if (shouldUseADAA != useADAA)
+    {
+        useADAA = shouldUseADAA;
+        reset();
+    }
+}
+
+void OutputStage::process (const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    jassert (block.getNumChannels() >= 2);
+
+    const int numSamples = (int) block.getNumSamples();
+
+    // Silent input stays silent through the gain and the limiter
+    if (activity.isIdle (block, [] { return 1; }))
+    {
+        gainSmoothed.skip (numSamples);
+        return;
+    }
+
+    // Gain: one ramp per chunk shared by both channels, scalar (or nothing) when steady
+    for (int start = 0; start < numSamples; start += maxBlockSize)
+    {
+        const int num = juce::jmin (numSamples - start, maxBlockSize);
+        const float* ramp = gainSmoothed.process (num);
+        const float gain = gainSmoothed.getCurrentValue();
+
+        for (size_t ch = 0; ch < 2; ++ch)
+        {
+            auto* data = block.getChannelPointer (ch) + start;
+
+            if (ramp != nullptr)
+                juce::FloatVectorOperations::multiply (data, ramp, num);
+            else if (gain != 1.0f)
+                juce::FloatVectorOperations::multiply (data, gain, num);
+        }
+    }
+
+    for (size_t ch = 0; ch < 2; ++ch)
+    {
+        auto* data = block.getChannelPointer (ch);
+
+        // Gentle final limiting
+        if (useADAA)
+        {
+            const ADAACurves::SoftClip limiter { 0.9 };
+            auto& state = limiterADAA[ch];
+
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = state.process (data[i], limiter);
+        }
+        else
+        {
+            FastMath::softClipBlock (data, 0.9f, numSamples);
+        }
+    }
+}
@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    OUTPUT - master gain and gentle final limiting
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "AntiAliasedShapers.h"
+#include "BlockSmoother.h"
+#include "StageActivity.h"
+
+class OutputStage
+{
+public:
+    void prepare (const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    void setGain (float linearGain)                          { gainSmoothed.setTargetValue (linearGain); }   // > 0
+    void setAntiAliasing (bool shouldUseADAA) noexcept;
+
+    // Stereo block, processed in place
+    void process (const juce::dsp::AudioBlock<float>& block) noexcept;
+
+private:
+    // Multiplicative: equal steps in dB
+    BlockSmoother<juce::ValueSmoothingTypes::Multiplicative> gainSmoothed { 1.0f };
+    int maxBlockSize = 0;
+
+    StageActivity activity;   // memoryless apart from the one-sample ADAA state
+
+    bool useADAA = false;
+    std::array<ADAA1<ADAACurves::SoftClip>, 2> limiterADAA;
+};
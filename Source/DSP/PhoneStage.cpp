@@ -0,0 +1,290 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+  ==============================================================================
+*/
+
+#include "PhoneStage.h"
+#include "FastMath.h"
+
+void PhoneStage::prepare (const juce::dsp::ProcessSpec& spec)
+{
+    interleaved.prepare ((int) spec.maximumBlockSize);
+    ringOutSamples = (int) (0.05 * spec.sampleRate);
+    amountSmoothed.prepare (spec.sampleRate, 0.02, interleaved.getCapacity());
+    mixSmoothed.prepare (spec.sampleRate, 0.05, interleaved.getCapacity());   // Longer ramp for bypass
+
+    // Integer factor keeps the resampler a plain polyphase FIR. Below 32 kHz
+    // the cascade simply runs at the host rate.
+    const int factor = juce::jmax (1, (int) (spec.sampleRate / targetInternalRate));
+    internalSampleRate = spec.sampleRate / factor;
+    coefficientTable = coefficientTables->getPhone (internalSampleRate);
+
+    resampler.prepare (factor, interleaved.getCapacity());
+    internalBuffer.assign ((size_t) resampler.getMaxInternalSamples (interleaved.getCapacity()),
+                           SIMDFloat::expand (0.0f));
+
+    codecPath.prepare (internalSampleRate, (int) internalBuffer.size());
+    codecAlignDelay.assign ((size_t) codecPath.getLatencySamples(), SIMDFloat::expand (0.0f));
+
+    juce::dsp::ProcessSpec stereoSpec { spec.sampleRate, spec.maximumBlockSize, 2 };
+    dryDelay.setMaximumDelayInSamples (resampler.getLatencySamples() + codecPath.getLatencySamples() * factor + 1);
+    dryDelay.prepare (stereoSpec);
+    dryDelay.setDelay ((float) getLatencySamples());
+
+    reset();
+}
+
+void PhoneStage::reset()
+{
+    filters.reset();
+    updateFilter (amountSmoothed.getCurrentValue(), true);
+    resampler.reset();
+    dryDelay.reset();
+    codecPath.reset();
+    std::fill (codecAlignDelay.begin(), codecAlignDelay.end(), SIMDFloat::expand (0.0f));
+    codecAlignPos = 0;
+    codecWasRunning = false;
+    isStale = false;
+}
+
+int PhoneStage::getLatencySamples() const noexcept
+{
+    const int codecLatency = codecEnabled ? codecPath.getLatencySamples() * resampler.getFactor() : 0;
+    return resampler.getLatencySamples() + codecLatency;
+}
+
+void PhoneStage::setCodecEnabled (bool shouldUseCodec) noexcept
+{
+    if (shouldUseCodec == codecEnabled)
+        return;
+
+    codecEnabled = shouldUseCodec;
+    dryDelay.setDelay ((float) getLatencySamples());
+    reset();
+}
+
+void PhoneStage::setEnabled (bool shouldBeEnabled, bool immediately)
+{
+    if (immediately)
+        mixSmoothed.setCurrentAndTargetValue (shouldBeEnabled ? 1.0f : 0.0f);
+    else
+        mixSmoothed.setTargetValue (shouldBeEnabled ? 1.0f : 0.0f);
+}
+
+void PhoneStage::updateFilter (float amount, bool immediately) noexcept
+{
+    if (coefficientTable == nullptr)
+        return;
+
+    const auto c = coefficientTable->lookup (mode, amount);
+    const SVFCoefficients* sections[] = { &c.highpass, &c.midBoost, &c.warmth, &c.lowpass, &c.postFilter };
+    filterAmount = amount;
+    filterMode = mode;
+
+    for (int k = 0; k < filters.numSections; ++k)
+    {
+        if (immediately)
+            filters.setSection (k, *sections[k]);
+        else
+            filters.setTargetSection (k, *sections[k]);
+    }
+}
+
+void PhoneStage::process (const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    jassert (block.getNumChannels() >= 2);
+
+    const int numSamples = (int) block.getNumSamples();
+    auto* left = block.getChannelPointer (0);
+    auto* right = block.getChannelPointer (1);
+
+    // Fully bypassed or fully dry for the whole block
+    if ((! mixSmoothed.isSmoothing() && mixSmoothed.getCurrentValue() <= 0.001f)
+     || (! amountSmoothed.isSmoothing() && amountSmoothed.getCurrentValue() <= 0.001f))
+    {
+        mixSmoothed.skip (numSamples);
+        amountSmoothed.skip (numSamples);
+
+        if (getLatencySamples() > 0)
+        {
+            auto stereo = block.getSubsetChannelBlock (0, 2);
+            dryDelay.process (juce::dsp::ProcessContextReplacing<float> (stereo));
+        }
+
+        isStale = true;
+        activity.reset();
+        return;
+    }
+
+    // Silent for longer than the latency and ring-out: the output is silent too
+    if (activity.isIdle (block, [this] { return getLatencySamples() + ringOutSamples; }))
+    {
+        mixSmoothed.skip (numSamples);
+        amountSmoothed.skip (numSamples);
+        return;
+    }
+
+    if (isStale)
+    {
+        // Don't let old filter and resampler state leak into the fade-in
+        filters.reset();
+        resampler.reset();
+        codecPath.reset();
+        codecWasRunning = false;
+        isStale = false;
+    }
+
+    for (int start = 0; start < numSamples; start += interleaved.getCapacity())
+    {
+        const int num = juce::jmin (numSamples - start, interleaved.getCapacity());
+        processChunk (left + start, right + start, num);
+    }
+}
+
+void PhoneStage::processChunk (float* left, float* right, int numSamples) noexcept
+{
+    // Multi-stage filtering with warmth, one pass through the fused cascade
+    // at the internal rate
+    // The ramps feed both the filter modulation and the mix
+    const bool isRamping = amountSmoothed.isSmoothing() || mixSmoothed.isSmoothing();
+    const float* amountRamp = isRamping ? amountSmoothed.processRamp (numSamples) : nullptr;
+    const float* mixRamp = isRamping ? mixSmoothed.processRamp (numSamples) : nullptr;
+
+    const float* channels[] = { left, right };
+    interleaved.pack (channels, 2, numSamples);
+
+    const int numInternal = resampler.decimate (interleaved.get(), numSamples, internalBuffer.data());
+    filterChunk (amountRamp, numSamples, numInternal);
+
+    if (codecEnabled)
+        processCodec (numInternal);
+
+    resampler.interpolate (internalBuffer.data(), interleaved.get(), numSamples);
+
+    // Dry path delayed to line up with the resampled wet path
+    if (getLatencySamples() > 0)
+    {
+        float* stereo[] = { left, right };
+        juce::dsp::AudioBlock<float> dry (stereo, 2, (size_t) numSamples);
+        dryDelay.process (juce::dsp::ProcessContextReplacing<float> (dry));
+    }
+
+    // Mode and ramp state are fixed for the chunk, so pick the loop once
+    switch (mode)
+    {
+        case 0:   isRamping ? mixChunk<0, true> (left, right, amountRamp, mixRamp, numSamples) : mixChunk<0, false> (left, right, nullptr, nullptr, numSamples); break;
+        case 2:   isRamping ? mixChunk<2, true> (left, right, amountRamp, mixRamp, numSamples) : mixChunk<2, false> (left, right, nullptr, nullptr, numSamples); break;
+        default:  isRamping ? mixChunk<1, true> (left, right, amountRamp, mixRamp, numSamples) : mixChunk<1, false> (left, right, nullptr, nullptr, numSamples); break;
+    }
+}
+
+void PhoneStage::filterChunk (const float* amountRamp, int numSamples, int numInternal) noexcept
+{
+    auto* data = internalBuffer.data();
+
+    // Steady amount: one design (if any) and a plain pass
+    if (amountRamp == nullptr)
+    {
+        if (amountSmoothed.getCurrentValue() != filterAmount || mode != filterMode)
+            updateFilter (amountSmoothed.getCurrentValue(), false);
+
+        filters.process (data, numInternal);
+        return;
+    }
+
+    for (int start = 0; start < numInternal; start += controlInterval)
+    {
+        const int num = juce::jmin (numInternal - start, controlInterval);
+
+        // Host-rate sample at the end of this control period
+        const int hostIndex = juce::jlimit (0, numSamples - 1, (start + num) * resampler.getFactor() - 1);
+        const float amount = amountRamp[hostIndex];
+
+        if (amount != filterAmount || mode != filterMode)
+            updateFilter (amount, false);
+
+        filters.process (data + start, num);
+    }
+}
+
+template <int Mode, bool IsRamping>
+void PhoneStage::mixChunk (float* left, float* right, const float* amountRamp,
+                           const float* mixRamp, int numSamples) noexcept
+{
+    // Steady: process() already skipped fully dry blocks, so every sample is wet
+    float phoneAmt = amountSmoothed.getCurrentValue();
+    float phoneMix = mixSmoothed.getCurrentValue();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if constexpr (IsRamping)
+        {
+            phoneAmt = amountRamp[i];
+            phoneMix = mixRamp[i];
+
+            if (phoneMix <= 0.001f || phoneAmt <= 0.001f)
+                continue;
+        }
+
+        float inL = left[i];
+        float inR = right[i];
+
+        float phoneL = interleaved.getSample (0, i);
+        float phoneR = interleaved.getSample (1, i);
+
+        // Gentle saturation for character (mode-dependent)
+        if constexpr (Mode == 0)  // Rotary - warm tube-like
+        {
+            phoneL = phoneL / (1.0f + std::abs (phoneL) * 0.2f * phoneAmt);
+            phoneR = phoneR / (1.0f + std::abs (phoneR) * 0.2f * phoneAmt);
+        }
+        else if constexpr (Mode == 2)  // Mobile - subtle digital compression
+        {
+            float comp = 1.0f + phoneAmt * 0.3f;
+            phoneL = FastMath::softClip (phoneL, comp);
+            phoneR = FastMath::softClip (phoneR, comp);
+        }
+
+        // Crossfade: dry->phone based on amount, then bypass crossfade
+        phoneL = inL * (1.0f - phoneAmt) + phoneL * phoneAmt;
+        phoneR = inR * (1.0f - phoneAmt) + phoneR * phoneAmt;
+
+        left[i] = inL * (1.0f - phoneMix) + phoneL * phoneMix;
+        right[i] = inR * (1.0f - phoneMix) + phoneR * phoneMix;
+    }
+}
+
+void PhoneStage::processCodec (int numInternal) noexcept
+{
+    auto* data = internalBuffer.data();
+    const int delayLength = (int) codecAlignDelay.size();
+
+    // The alignment delay is always fed so leaving Mobile mode is seamless
+    const bool runCodec = mode == 2;
+    int pos = codecAlignPos;
+
+    for (int i = 0; i < numInternal; ++i)
+    {
+        const auto delayed = codecAlignDelay[(size_t) pos];
+        codecAlignDelay[(size_t) pos] = data[i];
+        pos = pos + 1 == delayLength ? 0 : pos + 1;
+
+        if (! runCodec)
+            data[i] = delayed;
+    }
+
+    codecAlignPos = pos;
+
+    if (runCodec)
+    {
+        // Fresh codec state on entering Mobile mode
+        if (! codecWasRunning)
+            codecPath.reset();
+
+        codecPath.process (data, numInternal);
+    }
+
+    codecWasRunning = runCodec;
+}
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    PHONE - warm multi-stage vintage phone filter
+    Every mode is band-limited below ~4.6 kHz, so the filter cascade runs at
+    an internal rate near 16 kHz (host rate / integer factor, see
+    getInternalSampleRate) between a polyphase decimator and interpolator.
+    The dry path is delayed to match and the latency stays constant, on or off.
+    With the GSM codec enabled, Mobile mode also runs through a GSM 06.10
+    emulation, resampled to 8 kHz from the internal rate; the other modes are
+    delayed by the same amount so switching modes never changes the reported
+    latency.
+    The cascade follows the smoothed amount and the mode: it is looked up in
+    the shared coefficient table every controlInterval internal samples,
+    with its SVF coefficients interpolated linearly in between.
+  ==============================================================================
+*/
+
+#pragma once
+#include "FilterCoefficientTables.h"
+#include "GSMCodec.h"
+#include "BlockSmoother.h"
+#include "SIMDSVF.h"
+#include "StageActivity.h"
+
+class PhoneStage
+{
+public:
+    void prepare (const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    void setAmount (float amount01)                          { amountSmoothed.setTargetValue (amount01); }
+    void setMode (int newMode) noexcept                      { mode = newMode; }
+    void setCodecEnabled (bool shouldUseCodec) noexcept;
+    void setEnabled (bool shouldBeEnabled, bool immediately = false);
+
+    double getInternalSampleRate() const noexcept            { return internalSampleRate; }
+    int getLatencySamples() const noexcept;
+    int getMaxLatencySamples() const noexcept                { return dryDelay.getMaximumDelayInSamples(); }
+
+    // Stereo block, processed in place
+    void process (const juce::dsp::AudioBlock<float>& block) noexcept;
+
+private:
+    void processChunk (float* left, float* right, int numSamples) noexcept;
+
+    // Cascade over the internal buffer, redesigned from the amount at the
+    // end of each control period
+    void filterChunk (const float* amountRamp, int numSamples, int numInternal) noexcept;
+    void updateFilter (float amount, bool immediately) noexcept;
+
+    // Dry/wet mix, one instantiation per phone mode and ramp state
+    template <int Mode, bool IsRamping>
+    void mixChunk (float* left, float* right, const float* amountRamp, const float* mixRamp, int numSamples) noexcept;
+    void processCodec (int numInternal) noexcept;
+
+    static constexpr double targetInternalRate = 16000.0;
+    static constexpr int controlInterval = 16;   // ~1 ms at the internal rate
+
+    // highpass -> midBoost -> warmth -> lowpass -> postFilter, L/R in SIMD lanes
+    SIMDSVFCascade<5> filters;
+    SIMDInterleavedBuffer interleaved;
+    float filterAmount = 0.0f;   // amount and mode the cascade was last designed for
+    int filterMode = 0;
+
+    juce::SharedResourcePointer<FilterCoefficientTables> coefficientTables;
+    std::shared_ptr<const FilterCoefficientTables::PhoneTable> coefficientTable;   // at the internal rate
+
+    PolyphaseResampler resampler;
+    std::vector<SIMDFloat> internalBuffer;
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None> dryDelay;
+
+    // GSM path (Mobile) and the matching delay for the other modes, internal rate
+    GSMCodecPath codecPath;
+    std::vector<SIMDFloat> codecAlignDelay;
+    int codecAlignPos = 0;
+    bool codecEnabled = false;
+    bool codecWasRunning = false;
+
+    double internalSampleRate = 44100.0;
+    bool isStale = false;
+
+    StageActivity activity;
+    int ringOutSamples = 0;   // filter ring-out, on top of the latency
+
+    BlockSmoother<> amountSmoothed;
+    BlockSmoother<> mixSmoothed;
+
+    int mode = 0;
+};
@@ -0,0 +1,373 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+  ==============================================================================
+*/
+
+#include "PolyphaseResampler.h"
+
+namespace
+{
+    double besselI0 (double x) noexcept
+    {
+        double sum = 1.0, term = 1.0;
+
+        for (int k = 1; k < 64; ++k)
+        {
+            const double t = x / (2.0 * k);
+            term *= t * t;
+            sum += term;
+
+            if (term < sum * 1.0e-12)
+                break;
+        }
+
+        return sum;
+    }
+
+    // Kaiser-windowed sinc, ~70 dB stopband, normalised to unity DC gain.
+    // cutoff is relative to the rate the taps run at.
+    std::vector<double> designLowPass (int numTaps, double cutoff)
+    {
+        const double beta = 0.1102 * (70.0 - 8.7);
+        const double centre = 0.5 * (numTaps - 1);
+        const double norm = besselI0 (beta);
+
+        std::vector<double> h ((size_t) numTaps);
+        double sum = 0.0;
+
+        for (int k = 0; k < numTaps; ++k)
+        {
+            const double t = k - centre;
+            const double x = 2.0 * cutoff * t;
+            const double sinc = std::abs (x) < 1.0e-12 ? 1.0
+                                                       : std::sin (juce::MathConstants<double>::pi * x)
+                                                           / (juce::MathConstants<double>::pi * x);
+            const double r = t / centre;
+            const double window = besselI0 (beta * std::sqrt (juce::jmax (0.0, 1.0 - r * r))) / norm;
+
+            h[(size_t) k] = 2.0 * cutoff * sinc * window;
+            sum += h[(size_t) k];
+        }
+
+        for (auto& tap : h)
+            tap /= sum;
+
+        return h;
+    }
+}
+
+void PolyphaseResampler::prepare (int newFactor, int maxHostSamples, int newTapsPerPhase)
+{
+    juce::ignoreUnused (maxHostSamples);
+    jassert (newTapsPerPhase > 0 && newTapsPerPhase % 2 == 0);
+
+    factor = juce::jmax (1, newFactor);
+    tapsPerPhase = newTapsPerPhase;
+    numTaps = tapsPerPhase * factor;
+
+    // Cutoff at the internal Nyquist
+    const auto h = designLowPass (numTaps, 0.5 / factor);
+
+    // The decimator walks its history oldest first, so store h reversed
+    prototype.resize ((size_t) numTaps);
+    for (int k = 0; k < numTaps; ++k)
+        prototype[(size_t) k] = SIMDFloat::expand ((float) h[(size_t) (numTaps - 1 - k)]);
+
+    // Branch p holds factor * h[p + i * factor], newest internal sample first
+    phaseFilters.resize ((size_t) numTaps);
+    for (int p = 0; p < factor; ++p)
+        for (int i = 0; i < tapsPerPhase; ++i)
+            phaseFilters[(size_t) (p * tapsPerPhase + i)]
+                = SIMDFloat::expand ((float) (factor * h[(size_t) (p + i * factor)]));
+
+    decimatorHistory.resize ((size_t) (2 * numTaps));
+    interpolatorHistory.resize ((size_t) (2 * tapsPerPhase));
+
+    reset();
+}
+
+void PolyphaseResampler::reset() noexcept
+{
+    std::fill (decimatorHistory.begin(), decimatorHistory.end(), SIMDFloat::expand (0.0f));
+    std::fill (interpolatorHistory.begin(), interpolatorHistory.end(), SIMDFloat::expand (0.0f));
+    decimatorPos = interpolatorPos = 0;
+    decimatorPhase = interpolatorPhase = 0;
+}
+
+int PolyphaseResampler::decimate (const SIMDFloat* input, int numHostSamples, SIMDFloat* output) noexcept
+{
+    if (factor == 1)
+    {
+        std::copy (input, input + numHostSamples, output);
+        return numHostSamples;
+    }
+
+    int numOut = 0;
+    auto* history = decimatorHistory.data();
+    const auto* taps = prototype.data();
+
+    for (int n = 0; n < numHostSamples; ++n)
+    {
+        // Mirrored ring: the last numTaps inputs are always contiguous, oldest first
+        history[decimatorPos] = input[n];
+        history[decimatorPos + numTaps] = input[n];
+        decimatorPos = decimatorPos + 1 == numTaps ? 0 : decimatorPos + 1;
+
+        if (decimatorPhase == 0)
+        {
+            const auto* window = history + decimatorPos;
+            auto acc0 = SIMDFloat::expand (0.0f), acc1 = SIMDFloat::expand (0.0f);
+
+            // Two accumulators keep the multiply-adds independent
+            for (int k = 0; k < numTaps; k += 2)
+            {
+                acc0 += taps[k] * window[k];
+                acc1 += taps[k + 1] * window[k + 1];
+            }
+
+            output[numOut++] = acc0 + acc1;
+        }
+
+        decimatorPhase = decimatorPhase + 1 == factor ? 0 : decimatorPhase + 1;
+    }
+
+    return numOut;
+}
+
+void PolyphaseResampler::interpolate (const SIMDFloat* input, SIMDFloat* output, int numHostSamples) noexcept
+{
+    if (factor == 1)
+    {
+        std::copy (input, input + numHostSamples, output);
+        return;
+    }
+
+    int numIn = 0;
+    auto* history = interpolatorHistory.data();
+
+    for (int n = 0; n < numHostSamples; ++n)
+    {
+        // A new internal sample lands on every phase 0, same as in decimate()
+        if (interpolatorPhase == 0)
+        {
+            interpolatorPos = interpolatorPos == 0 ? tapsPerPhase - 1 : interpolatorPos - 1;
+            history[interpolatorPos] = input[numIn];
+            history[interpolatorPos + tapsPerPhase] = input[numIn];
+            ++numIn;
+        }
+
+        // Newest first from interpolatorPos
+        const auto* window = history + interpolatorPos;
+        const auto* branch = phaseFilters.data() + interpolatorPhase * tapsPerPhase;
+        auto acc0 = SIMDFloat::expand (0.0f), acc1 = SIMDFloat::expand (0.0f);
+
+        for (int i = 0; i < tapsPerPhase; i += 2)
+        {
+            acc0 += branch[i] * window[i];
+            acc1 += branch[i + 1] * window[i + 1];
+        }
+
+        output[n] = acc0 + acc1;
+        interpolatorPhase = interpolatorPhase + 1 == factor ? 0 : interpolatorPhase + 1;
+    }
+}
+
+int PolyphaseResampler::skipSilence (int numHostSamples) noexcept
+{
+    std::fill (decimatorHistory.begin(), decimatorHistory.end(), SIMDFloat::expand (0.0f));
+    std::fill (interpolatorHistory.begin(), interpolatorHistory.end(), SIMDFloat::expand (0.0f));
+
+    if (factor == 1 || numHostSamples <= 0)
+        return juce::jmax (0, numHostSamples);
+
+    // Outputs land where the phase wraps to 0; both directions share the phase
+    const int first = (factor - decimatorPhase) % factor;
+    const int numOut = first < numHostSamples ? (numHostSamples - 1 - first) / factor + 1 : 0;
+
+    decimatorPhase = (decimatorPhase + numHostSamples) % factor;
+    interpolatorPhase = (interpolatorPhase + numHostSamples) % factor;
+    return numOut;
+}
+
+//==============================================================================
+void RationalResampler::prepare (double newHostRate, double internalRate, int maxHostSamples,
+                                 int tapsPerPhase, int internalDelay)
+{
+    juce::ignoreUnused (maxHostSamples);
+    jassert (newHostRate > 0.0 && internalRate > 0.0 && tapsPerPhase > 0 && internalDelay >= 0);
+
+    hostRate = newHostRate;
+
+    // Last continued-fraction convergent of the ratio with down <= maxDownFactor
+    {
+        double x = internalRate / hostRate;
+        juce::int64 p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+
+        for (int i = 0; i < 32; ++i)
+        {
+            const double a = std::floor (x);
+            const auto p2 = (juce::int64) a * p1 + p0;
+            const auto q2 = (juce::int64) a * q1 + q0;
+
+            if (q2 > maxDownFactor)
+                break;
+
+            p0 = p1; q0 = q1;
+            p1 = p2; q1 = q2;
+
+            const double frac = x - a;
+
+            if (frac < 1.0e-9)
+                break;
+
+            x = 1.0 / frac;
+        }
+
+        upFactor = (int) juce::jmax ((juce::int64) 1, p1);
+        downFactor = (int) juce::jmax ((juce::int64) 1, q1);
+    }
+
+    const int L = upFactor, M = downFactor;
+
+    if (L == M)
+    {
+        latency = internalDelay;
+        decimatorTaps = interpolatorTaps = 0;
+        reset();
+        return;
+    }
+
+    // Group delays at the prototype rate: (N - 1) / 2 each way plus
+    // internalDelay * M in between. Round N - 1 up from tapsPerPhase * max (L, M)
+    // until that total is a multiple of L.
+    const int remainder = (int) (((juce::int64) internalDelay * M) % L);
+    const int minLength = tapsPerPhase * juce::jmax (L, M);
+    const int k = (minLength + remainder + L - 1) / L;
+    const int numTaps = k * L - remainder + 1;
+    latency = (int) (((juce::int64) numTaps - 1 + (juce::int64) internalDelay * M) / L);
+
+    // Cutoff at the lower of the two Nyquist frequencies
+    const auto h = designLowPass (numTaps, 0.5 / juce::jmax (L, M));
+    const auto tap = [&] (int index) { return juce::isPositiveAndBelow (index, numTaps) ? h[(size_t) index] : 0.0; };
+
+    // Decimator branch p: the output sits p taps behind the newest input,
+    // so host sample n - j meets tap j * L - p (scaled by L for the zeros)
+    decimatorTaps = (numTaps + L - 1 + L - 1) / L;
+    decimatorTaps += decimatorTaps % 2;
+    decimatorBranches.resize ((size_t) (L * decimatorTaps));
+
+    for (int p = 0; p < L; ++p)
+        for (int j = 0; j < decimatorTaps; ++j)
+            decimatorBranches[(size_t) (p * decimatorTaps + j)] = (float) (L * tap (j * L - p));
+
+    // Interpolator branch p: the output sits p taps past the newest internal
+    // sample, so internal sample m - j meets tap p + j * M (scaled by M)
+    interpolatorTaps = (numTaps + M - 1) / M;
+    interpolatorTaps += interpolatorTaps % 2;
+    interpolatorBranches.resize ((size_t) (M * interpolatorTaps));
+
+    for (int p = 0; p < M; ++p)
+        for (int j = 0; j < interpolatorTaps; ++j)
+            interpolatorBranches[(size_t) (p * interpolatorTaps + j)] = (float) (M * tap (p + j * M));
+
+    decimatorHistory.resize ((size_t) (2 * decimatorTaps));
+    interpolatorHistory.resize ((size_t) (2 * interpolatorTaps));
+
+    reset();
+}
+
+void RationalResampler::reset() noexcept
+{
+    std::fill (decimatorHistory.begin(), decimatorHistory.end(), SIMDFloat::expand (0.0f));
+    std::fill (interpolatorHistory.begin(), interpolatorHistory.end(), SIMDFloat::expand (0.0f));
+    decimatorPos = interpolatorPos = 0;
+    decimatorWait = interpolatorPending = 1;
+    decimatorPhase = interpolatorPhase = 0;
+}
+
+int RationalResampler::decimate (const SIMDFloat* input, int numHostSamples, SIMDFloat* output) noexcept
+{
+    if (upFactor == downFactor)
+    {
+        std::copy (input, input + numHostSamples, output);
+        return numHostSamples;
+    }
+
+    int numOut = 0;
+    auto* history = decimatorHistory.data();
+
+    for (int n = 0; n < numHostSamples; ++n)
+    {
+        decimatorPos = decimatorPos == 0 ? decimatorTaps - 1 : decimatorPos - 1;
+        history[decimatorPos] = input[n];
+        history[decimatorPos + decimatorTaps] = input[n];
+
+        while (--decimatorWait == 0)
+        {
+            const auto* window = history + decimatorPos;
+            const auto* branch = decimatorBranches.data() + decimatorPhase * decimatorTaps;
+            auto acc0 = SIMDFloat::expand (0.0f), acc1 = SIMDFloat::expand (0.0f);
+
+            for (int j = 0; j < decimatorTaps; j += 2)
+            {
+                acc0 += window[j] * branch[j];
+                acc1 += window[j + 1] * branch[j + 1];
+            }
+
+            output[numOut++] = acc0 + acc1;
+
+            // The next output is down taps later
+            decimatorPhase -= downFactor;
+            decimatorWait = 1;
+
+            while (decimatorPhase < 0)
+            {
+                decimatorPhase += upFactor;
+                ++decimatorWait;
+            }
+        }
+    }
+
+    return numOut;
+}
+
+void RationalResampler::interpolate (const SIMDFloat* input, SIMDFloat* output, int numHostSamples) noexcept
+{
+    if (upFactor == downFactor)
+    {
+        std::copy (input, input + numHostSamples, output);
+        return;
+    }
+
+    int numIn = 0;
+    auto* history = interpolatorHistory.data();
+
+    for (int n = 0; n < numHostSamples; ++n)
+    {
+        for (; interpolatorPending > 0; --interpolatorPending)
+        {
+            interpolatorPos = interpolatorPos == 0 ? interpolatorTaps - 1 : interpolatorPos - 1;
+            history[interpolatorPos] = input[numIn];
+            history[interpolatorPos + interpolatorTaps] = input[numIn];
+            ++numIn;
+        }
+
+        const auto* window = history + interpolatorPos;
+        const auto* branch = interpolatorBranches.data() + interpolatorPhase * interpolatorTaps;
+        auto acc0 = SIMDFloat::expand (0.0f), acc1 = SIMDFloat::expand (0.0f);
+
+        for (int j = 0; j < interpolatorTaps; j += 2)
+        {
+            acc0 += window[j] * branch[j];
+            acc1 += window[j + 1] * branch[j + 1];
+        }
+
+        output[n] = acc0 + acc1;
+
+        // The next output is up taps later
+        for (interpolatorPhase += upFactor; interpolatorPhase >= downFactor; interpolatorPhase -= downFactor)
+            ++interpolatorPending;
+    }
+}
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    Integer-factor polyphase FIR decimator / interpolator pair.
+    Channels ride in SIMD lanes like SIMDBiquadCascade. Both directions share
+    one Kaiser-windowed sinc prototype of tapsPerPhase * factor taps, cut off
+    at the internal Nyquist frequency. The decimator only evaluates the
+    output phase it keeps and the interpolator only the branch it needs, so
+    each direction costs tapsPerPhase multiply-adds per host sample.
+
+    Linear phase, streaming across blocks, allocation-free after prepare().
+    Round-trip latency is exactly numTaps - 1 host samples.
+
+    RationalResampler does the same for rates that are not an integer
+    division of the host rate (e.g. 8 kHz from 22.05 kHz, 160/441). The
+    prototype runs at host rate * up and is kept in up decimator branches
+    and down interpolator branches, so each output still costs one
+    branch of multiply-adds. Outputs come out the moment their newest
+    input is in, and the interpolator takes each internal sample at the
+    matching host sample, so decimate() and interpolate() stay in step
+    across blocks.
+  ==============================================================================
+*/
+
+#pragma once
+#include "SIMDBiquad.h"
+
+class PolyphaseResampler
+{
+public:
+    static constexpr int defaultTapsPerPhase = 16;
+
+    // factor 1 turns both directions into a plain copy with no latency.
+    // More taps per phase narrow the transition band (must be even).
+    void prepare (int factor, int maxHostSamples, int tapsPerPhase = defaultTapsPerPhase);
+    void reset() noexcept;
+
+    int getFactor() const noexcept              { return factor; }
+    int getLatencySamples() const noexcept      { return factor > 1 ? numTaps - 1 : 0; }
+
+    // Largest number of internal samples one decimate() call can produce
+    int getMaxInternalSamples (int numHostSamples) const noexcept   { return numHostSamples / factor + 1; }
+
+    // Host rate in, internal rate out. Returns the number of internal samples written.
+    int decimate (const SIMDFloat* input, int numHostSamples, SIMDFloat* output) noexcept;
+
+    // Consumes the internal samples produced by the matching decimate() call
+    // and writes numHostSamples host rate samples.
+    void interpolate (const SIMDFloat* input, SIMDFloat* output, int numHostSamples) noexcept;
+
+    // Both directions move on as if numHostSamples of silence had gone
+    // through (the histories are cleared, the phases advance). Returns the
+    // number of internal samples decimate() would have produced.
+    int skipSilence (int numHostSamples) noexcept;
+
+private:
+    int factor = 1;
+    int tapsPerPhase = defaultTapsPerPhase;
+    int numTaps = 0;
+
+    std::vector<SIMDFloat> prototype;       // numTaps, time reversed for the decimator
+    std::vector<SIMDFloat> phaseFilters;    // factor branches of tapsPerPhase, scaled by factor
+
+    std::vector<SIMDFloat> decimatorHistory;      // 2 * numTaps, mirrored
+    std::vector<SIMDFloat> interpolatorHistory;   // 2 * tapsPerPhase, mirrored
+    int decimatorPos = 0, interpolatorPos = 0;
+
+    int decimatorPhase = 0, interpolatorPhase = 0;
+};
+
+//==============================================================================
+class RationalResampler
+{
+public:
+    static constexpr int maxDownFactor = 1024;
+
+    // The ratio internalRate / hostRate is reduced to up / down, or to the
+    // closest fraction with down <= maxDownFactor for odd rates.
+    // internalDelay is the number of internal samples the caller holds back
+    // between decimate() and interpolate(): the prototype length is trimmed
+    // by up to up - 1 taps so the whole round trip is a whole number of
+    // host samples.
+    void prepare (double hostRate, double internalRate, int maxHostSamples,
+                  int tapsPerPhase = PolyphaseResampler::defaultTapsPerPhase, int internalDelay = 0);
+    void reset() noexcept;
+
+    double getInternalSampleRate() const noexcept   { return hostRate * upFactor / downFactor; }
+
+    // Round trip in host samples, internalDelay included
+    int getLatencySamples() const noexcept          { return latency; }
+
+    // Largest number of internal samples one decimate() call can produce
+    int getMaxInternalSamples (int numHostSamples) const noexcept
+    {
+        return (int) ((juce::int64) numHostSamples * upFactor / downFactor) + 1;
+    }
+
+    // Same contract as PolyphaseResampler
+    int decimate (const SIMDFloat* input, int numHostSamples, SIMDFloat* output) noexcept;
+    void interpolate (const SIMDFloat* input, SIMDFloat* output, int numHostSamples) noexcept;
+
+private:
+    int upFactor = 1, downFactor = 1;
+    double hostRate = 44100.0;
+    int latency = 0;
+
+    // Branches are scalar (both lanes use the same taps), each padded to an even length
+    int decimatorTaps = 0, interpolatorTaps = 0;
+    std::vector<float> decimatorBranches;      // upFactor branches, newest host sample first
+    std::vector<float> interpolatorBranches;   // downFactor branches, newest internal sample first
+
+    std::vector<SIMDFloat> decimatorHistory, interpolatorHistory;   // mirrored, newest first
+    int decimatorPos = 0, interpolatorPos = 0;
+
+    // Decimator: host samples still to come before the next output, and how
+    // far (in prototype taps) that output sits behind its newest input.
+    // Interpolator: internal samples to take in before the next output, and
+    // how far that output sits past its newest internal sample.
+    int decimatorWait = 1, decimatorPhase = 0;
+    int interpolatorPending = 1, interpolatorPhase = 0;
+};
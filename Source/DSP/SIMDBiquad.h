@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    SIMD biquad kernels - one channel per SIMD lane.
+    L/R (or up to SIMDNumElements channels) share one set of coefficients
+    and run through transposed direct form II sections, so a stereo pair
+    costs one vector biquad instead of two scalar ones.
+  ==============================================================================
+*/
+
+#pragma once
+#include "BiquadDesign.h"
+
+using SIMDFloat = juce::dsp::SIMDRegister<float>;
+
+// Fused second-order-sections cascade. All coefficients and states sit in two
+// contiguous arrays and a block goes through every section in one pass, so the
+// intermediate signal and the states never leave registers between sections.
+template <int NumSections>
+class SIMDBiquadCascade
+{
+public:
+    static constexpr int numSections = NumSections;
+
+    SIMDBiquadCascade() noexcept   { reset(); }
+
+    void setSection (int index, const BiquadCoefficients& c) noexcept
+    {
+        jassert (juce::isPositiveAndBelow (index, NumSections));
+        auto& s = sections[(size_t) index];
+        s.b0 = SIMDFloat::expand (c.b0);
+        s.b1 = SIMDFloat::expand (c.b1);
+        s.b2 = SIMDFloat::expand (c.b2);
+        s.a1 = SIMDFloat::expand (c.a1);
+        s.a2 = SIMDFloat::expand (c.a2);
+    }
+
+    void reset() noexcept
+    {
+        state.fill (SIMDFloat::expand (0.0f));
+    }
+
+    SIMDFloat processSample (SIMDFloat x) noexcept
+    {
+        for (int k = 0; k < NumSections; ++k)
+            x = tick (sections[(size_t) k], state[(size_t) (2 * k)], state[(size_t) (2 * k + 1)], x);
+
+        return x;
+    }
+
+    void process (SIMDFloat* data, int numSamples) noexcept
+    {
+        // Work on a local copy so the compiler can keep the states in registers
+        auto z = state;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto x = data[i];
+
+            for (int k = 0; k < NumSections; ++k)
+                x = tick (sections[(size_t) k], z[(size_t) (2 * k)], z[(size_t) (2 * k + 1)], x);
+
+            data[i] = x;
+        }
+
+        state = z;
+    }
+
+private:
+    struct Section
+    {
+        SIMDFloat b0 = SIMDFloat::expand (1.0f), b1 = SIMDFloat::expand (0.0f), b2 = SIMDFloat::expand (0.0f);
+        SIMDFloat a1 = SIMDFloat::expand (0.0f), a2 = SIMDFloat::expand (0.0f);
+    };
+
+    static SIMDFloat tick (const Section& s, SIMDFloat& s1, SIMDFloat& s2, SIMDFloat x) noexcept
+    {
+        auto y = s.b0 * x + s1;
+        s1 = s.b1 * x - s.a1 * y + s2;
+        s2 = s.b2 * x - s.a2 * y;
+        return y;
+    }
+
+    std::array<Section, (size_t) NumSections> sections;
+    std::array<SIMDFloat, (size_t) (2 * NumSections)> state;   // s1, s2 per section
+};
+
+//==============================================================================
+// Channel-interleaved scratch: sample i of channel c lives in lane c of data[i].
+// Unused lanes are kept at zero so they never produce denormals or NaNs.
+class SIMDInterleavedBuffer
+{
+public:
+    static constexpr int maxChannels = (int) SIMDFloat::SIMDNumElements;
+
+    void prepare (int maxSamples)
+    {
+        data.assign ((size_t) juce::jmax (1, maxSamples), SIMDFloat::expand (0.0f));
+    }
+
+    int getCapacity() const noexcept                { return (int) data.size(); }
+    SIMDFloat* get() noexcept                       { return data.data(); }
+
+    float* getRaw() noexcept                        { return reinterpret_cast<float*> (data.data()); }
+    float getSample (int channel, int index) const noexcept
+    {
+        return reinterpret_cast<const float*> (data.data())[index * maxChannels + channel];
+    }
+
+    void pack (const float* const* channels, int numChannels, int numSamples) noexcept
+    {
+        jassert (numChannels <= maxChannels && numSamples <= getCapacity());
+        auto* raw = getRaw();
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                raw[i * maxChannels + ch] = channels[ch][i];
+    }
+
+    void unpack (float* const* channels, int numChannels, int numSamples) const noexcept
+    {
+        jassert (numChannels <= maxChannels && numSamples <= (int) data.size());
+        auto* raw = reinterpret_cast<const float*> (data.data());
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                channels[ch][i] = raw[i * maxChannels + ch];
+    }
+
+private:
+    std::vector<SIMDFloat> data;
+};
+
+//==============================================================================
+// Per-sample packing for feedback loops that cannot be run block-wise
+inline SIMDFloat packStereo (float left, float right) noexcept
+{
+    alignas (SIMDFloat::SIMDRegisterSize) float lanes[SIMDFloat::SIMDNumElements] = {};
+    lanes[0] = left;
+    lanes[1] = right;
+    return SIMDFloat::fromRawArray (lanes);
+}
+
+inline void unpackStereo (SIMDFloat v, float& left, float& right) noexcept
+{
+    alignas (SIMDFloat::SIMDRegisterSize) float lanes[SIMDFloat::SIMDNumElements];
+    v.copyToRawArray (lanes);
+    left = lanes[0];
+    right = lanes[1];
+}
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    SIMD state-variable filter cascade - one channel per SIMD lane.
+    Same fused layout as SIMDBiquadCascade, but with TPT SVF sections whose
+    coefficients can be ramped: setTargetSection() makes the next process()
+    call interpolate linearly from the current design to the new one, so a
+    modulated filter only needs a fresh design every control period.
+  ==============================================================================
+*/
+
+#pragma once
+#include "SVFDesign.h"
+#include "SIMDBiquad.h"
+
+template <int NumSections>
+class SIMDSVFCascade
+{
+public:
+    static constexpr int numSections = NumSections;
+
+    SIMDSVFCascade() noexcept   { reset(); }
+
+    // Jumps straight to the new design
+    void setSection (int index, const SVFCoefficients& c) noexcept
+    {
+        jassert (juce::isPositiveAndBelow (index, NumSections));
+        current[(size_t) index] = target[(size_t) index] = c;
+    }
+
+    // The next process() call ramps from the current design to this one
+    void setTargetSection (int index, const SVFCoefficients& c) noexcept
+    {
+        jassert (juce::isPositiveAndBelow (index, NumSections));
+        target[(size_t) index] = c;
+        isRamping = true;
+    }
+
+    void reset() noexcept
+    {
+        state.fill (SIMDFloat::expand (0.0f));
+    }
+
+    void process (SIMDFloat* data, int numSamples) noexcept
+    {
+        if (numSamples <= 0)
+            return;
+
+        // Work on local copies so the compiler can keep everything in registers
+        auto z = state;
+        std::array<Section, (size_t) NumSections> c;
+
+        for (size_t k = 0; k < (size_t) NumSections; ++k)
+            c[k] = Section (current[k]);
+
+        if (isRamping)
+        {
+            std::array<Section, (size_t) NumSections> delta;
+            const float scale = 1.0f / (float) numSamples;
+
+            for (size_t k = 0; k < (size_t) NumSections; ++k)
+                delta[k] = Section (current[k], target[k], scale);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto x = data[i];
+
+                for (size_t k = 0; k < (size_t) NumSections; ++k)
+                {
+                    c[k].advance (delta[k]);
+                    x = tick (c[k], z[2 * k], z[2 * k + 1], x);
+                }
+
+                data[i] = x;
+            }
+
+            // Land exactly on the target, whatever the rounding along the way
+            current = target;
+            isRamping = false;
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto x = data[i];
+
+                for (size_t k = 0; k < (size_t) NumSections; ++k)
+                    x = tick (c[k], z[2 * k], z[2 * k + 1], x);
+
+                data[i] = x;
+            }
+        }
+
+        state = z;
+    }
+
+private:
+    struct Section
+    {
+        Section() noexcept = default;
+
+        explicit Section (const SVFCoefficients& s) noexcept
+            : a1 (SIMDFloat::expand (s.a1)), a2 (SIMDFloat::expand (s.a2)), a3 (SIMDFloat::expand (s.a3)),
+              m0 (SIMDFloat::expand (s.m0)), m1 (SIMDFloat::expand (s.m1)), m2 (SIMDFloat::expand (s.m2)) {}
+
+        // Per-sample step from one design to the other
+        Section (const SVFCoefficients& from, const SVFCoefficients& to, float scale) noexcept
+            : a1 (SIMDFloat::expand ((to.a1 - from.a1) * scale)), a2 (SIMDFloat::expand ((to.a2 - from.a2) * scale)),
+              a3 (SIMDFloat::expand ((to.a3 - from.a3) * scale)), m0 (SIMDFloat::expand ((to.m0 - from.m0) * scale)),
+              m1 (SIMDFloat::expand ((to.m1 - from.m1) * scale)), m2 (SIMDFloat::expand ((to.m2 - from.m2) * scale)) {}
+
+        void advance (const Section& d) noexcept
+        {
+            a1 += d.a1;  a2 += d.a2;  a3 += d.a3;
+            m0 += d.m0;  m1 += d.m1;  m2 += d.m2;
+        }
+
+        SIMDFloat a1, a2, a3, m0, m1, m2;
+    };
+
+    static SIMDFloat tick (const Section& c, SIMDFloat& ic1, SIMDFloat& ic2, SIMDFloat x) noexcept
+    {
+        const auto v3 = x - ic2;
+        const auto v1 = c.a1 * ic1 + c.a2 * v3;           // band
+        const auto v2 = ic2 + c.a2 * ic1 + c.a3 * v3;     // low
+        ic1 = v1 + v1 - ic1;
+        ic2 = v2 + v2 - ic2;
+        return c.m0 * x + c.m1 * v1 + c.m2 * v2;
+    }
+
+    std::array<SVFCoefficients, (size_t) NumSections> current, target;
+    std::array<SIMDFloat, (size_t) (2 * NumSections)> state;   // ic1, ic2 per section
+    bool isRamping = false;
+};
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    Topology-preserving-transform state-variable filter design.
+    Trapezoidal SVF (Simper / Zavalishin) with the same responses as the
+    RBJ shapes in BiquadDesign. A design costs one tan(), and unlike
+    biquad coefficients the SVF ones can be interpolated linearly between
+    two designs without the filter blowing up or zippering, so modulated
+    sections can be redesigned at control rate and ramped in between.
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// One SVF section: a1..a3 drive the integrators, the output is
+// m0 * input + m1 * band + m2 * low. The defaults pass the input through.
+struct SVFCoefficients
+{
+    float a1 = 1.0f, a2 = 0.0f, a3 = 0.0f;
+    float m0 = 1.0f, m1 = 0.0f, m2 = 0.0f;
+};
+
+namespace SVFDesign
+{
+    inline SVFCoefficients make (double g, double k, double m0, double m1, double m2) noexcept
+    {
+        const double a1 = 1.0 / (1.0 + g * (g + k));
+        const double a2 = g * a1;
+        return { (float) a1, (float) a2, (float) (g * a2), (float) m0, (float) m1, (float) m2 };
+    }
+
+    inline double prewarp (double sampleRate, double frequency) noexcept
+    {
+        jassert (sampleRate > 0.0 && frequency > 0.0 && frequency < sampleRate * 0.5);
+        return std::tan (juce::MathConstants<double>::pi * frequency / sampleRate);
+    }
+
+    inline SVFCoefficients makeLowPass (double sampleRate, double frequency, double q) noexcept
+    {
+        jassert (q > 0.0);
+        return make (prewarp (sampleRate, frequency), 1.0 / q, 0.0, 0.0, 1.0);
+    }
+
+    inline SVFCoefficients makeHighPass (double sampleRate, double frequency, double q) noexcept
+    {
+        jassert (q > 0.0);
+        const double k = 1.0 / q;
+        return make (prewarp (sampleRate, frequency), k, 1.0, -k, -1.0);
+    }
+
+    // gainFactor is the linear gain at the centre, as in BiquadDesign
+    inline SVFCoefficients makePeakFilter (double sampleRate, double frequency,
+                                           double q, double gainFactor) noexcept
+    {
+        jassert (q > 0.0 && gainFactor > 0.0);
+        const double A = std::sqrt (gainFactor);
+        const double k = 1.0 / (q * A);
+        return make (prewarp (sampleRate, frequency), k, 1.0, k * (gainFactor - 1.0), 0.0);
+    }
+
+    // gainFactor is the linear gain below the shelf, as in BiquadDesign
+    inline SVFCoefficients makeLowShelf (double sampleRate, double frequency,
+                                         double q, double gainFactor) noexcept
+    {
+        jassert (q > 0.0 && gainFactor > 0.0);
+        const double A = std::sqrt (gainFactor);
+        const double k = 1.0 / q;
+        return make (prewarp (sampleRate, frequency) / std::sqrt (A), k, 1.0, k * (A - 1.0), gainFactor - 1.0);
+    }
+
+    // Straight-line blend of two designs, t in [0, 1]
+    inline SVFCoefficients interpolate (const SVFCoefficients& a, const SVFCoefficients& b, float t) noexcept
+    {
+        return { a.a1 + t * (b.a1 - a.a1), a.a2 + t * (b.a2 - a.a2), a.a3 + t * (b.a3 - a.a3),
+                 a.m0 + t * (b.m0 - a.m0), a.m1 + t * (b.m1 - a.m1), a.m2 + t * (b.m2 - a.m2) };
+    }
+}
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    Silence detection so idle stages can sleep.
+    Ad-lib tracks are mostly silence. A stage asks isIdle() with its input
+    block and its tail (latency, filter ring-out, delay repeats): once the
+    input has stayed below silenceThreshold for the whole tail, the stage's
+    output is silent too, so it leaves the block as it is and only advances
+    its smoothers. The first block with signal wakes it with its state
+    intact. The check is one min/max scan per channel.
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class StageActivity
+{
+public:
+    static constexpr float silenceThreshold = 1.0e-5f;   // -100 dBFS
+
+    // Forget the silence counted so far (the next sleep waits a full tail)
+    void reset() noexcept                            { silentSamples = 0; }
+
+    // Call once per block, before processing it. getTailSamples() is only
+    // evaluated for silent blocks.
+    template <typename TailFunction>
+    bool isIdle (const juce::dsp::AudioBlock<float>& block, TailFunction&& getTailSamples) noexcept
+    {
+        const auto numSamples = (juce::int64) block.getNumSamples();
+
+        if (! isSilent (block))
+        {
+            silentSamples = 0;
+            return false;
+        }
+
+        const bool idle = (double) silentSamples >= (double) getTailSamples();
+        silentSamples = juce::jmin (silentSamples + numSamples, maxCount);
+        return idle;
+    }
+
+private:
+    static bool isSilent (const juce::dsp::AudioBlock<float>& block) noexcept
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+        {
+            const auto range = juce::FloatVectorOperations::findMinAndMax (block.getChannelPointer (ch),
+                                                                           (int) block.getNumSamples());
+
+            if (range.getStart() <= -silenceThreshold || range.getEnd() >= silenceThreshold)
+                return false;
+        }
+
+        return true;
+    }
+
+    static constexpr juce::int64 maxCount = std::numeric_limits<juce::int64>::max() / 2;
+    juce::int64 silentSamples = 0;
+};
@@ -0,0 +1,306 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+  ==============================================================================
+*/
+
+#include "StereoDelayBuffer.h"
+
+namespace
+{
+    struct Float32Storage
+    {
+        using Sample = float;
+
+        static float load (Sample s) noexcept                          { return s; }
+        static Sample store (float x, uint32_t&) noexcept              { return x; }
+    };
+
+    struct Int16Storage
+    {
+        using Sample = int16_t;
+
+        // +-4 full scale leaves 12 dB for hot feedback before clipping
+        static constexpr float scale = 8192.0f;
+        static constexpr float invScale = 1.0f / scale;
+
+        static float load (Sample s) noexcept                          { return (float) s * invScale; }
+
+        static Sample store (float x, uint32_t& rng) noexcept
+        {
+            // TPDF dither: sum of two uniform [-0.5, 0.5) LSB values
+            rng = rng * 1664525u + 1013904223u;
+            const float r1 = (float) (rng >> 8) * (1.0f / 16777216.0f);
+            rng = rng * 1664525u + 1013904223u;
+            const float r2 = (float) (rng >> 8) * (1.0f / 16777216.0f);
+
+            const float v = x * scale + (r1 - r2);
+            return (Sample) juce::jlimit (-32768, 32767, (int) std::floor (v + 0.5f));
+        }
+    };
+
+    struct Float16Storage
+    {
+        using Sample = int16_t;   // IEEE half bit pattern
+
+        static float load (Sample s) noexcept
+        {
+            const auto h = (uint32_t) (uint16_t) s;
+            const uint32_t sign = (h & 0x8000u) << 16;
+            const uint32_t exponent = (h >> 10) & 0x1fu;
+
+            // store() flushes subnormals and saturates, so 0 and 31 never carry data
+            const uint32_t bits = exponent == 0 ? sign
+                                                : sign | ((exponent + 112u) << 23) | ((h & 0x3ffu) << 13);
+            float f;
+            std::memcpy (&f, &bits, sizeof (f));
+            return f;
+        }
+
+        static Sample store (float x, uint32_t&) noexcept
+        {
+            uint32_t bits;
+            std::memcpy (&bits, &x, sizeof (bits));
+
+            const uint32_t sign = (bits >> 16) & 0x8000u;
+            const int exponent = (int) ((bits >> 23) & 0xffu) - 112;
+            const uint32_t mantissa = bits & 0x7fffffu;
+
+            // Below the smallest normal half (~6e-5, -84 dBFS): flush to zero
+            if (exponent <= 0)
+                return (Sample) sign;
+
+            // Round to nearest even on the 13 dropped bits, carries into the exponent
+            uint32_t h = ((uint32_t) exponent << 10) | (mantissa >> 13);
+            const uint32_t rest = mantissa & 0x1fffu;
+
+            if (rest > 0x1000u || (rest == 0x1000u && (h & 1u) != 0))
+                ++h;
+
+            // Saturate to the largest finite half instead of producing inf
+            return (Sample) (sign | juce::jmin (h, 0x7bffu));
+        }
+    };
+}
+
+void StereoDelayBuffer::prepare (int maxDelaySamples, int maxBlockSize, DelayStorage newStorage)
+{
+    maxDelay = maxDelaySamples;
+    storage = newStorage;
+
+    // Room for the longest delay, one block and the interpolation neighbours
+    const int capacity = juce::nextPowerOfTwo (maxDelaySamples + maxBlockSize + 4);
+    mask = capacity - 1;
+
+    // Same rate, block size and storage again: keep the memory, reset() clears it
+    const auto resizeOrRelease = [capacity] (auto& v, bool isUsed)
+    {
+        const size_t wanted = isUsed ? (size_t) (2 * capacity) : 0;
+
+        if (v.size() != wanted)
+        {
+            v.clear();
+            v.shrink_to_fit();
+            v.resize (wanted);
+        }
+    };
+
+    resizeOrRelease (floatBuffer, storage == DelayStorage::float32);
+    resizeOrRelease (shortBuffer, storage != DelayStorage::float32);
+
+    reset();
+}
+
+void StereoDelayBuffer::reset() noexcept
+{
+    // All-zero bits are 0.0 in every storage format
+    std::fill (floatBuffer.begin(), floatBuffer.end(), 0.0f);
+    std::fill (shortBuffer.begin(), shortBuffer.end(), (int16_t) 0);
+    writePos = 0;
+    thiranState = {};
+}
+
+size_t StereoDelayBuffer::getMemoryBytes() const noexcept
+{
+    return floatBuffer.size() * sizeof (float) + shortBuffer.size() * sizeof (int16_t);
+}
+
+void StereoDelayBuffer::setInterpolation (DelayInterpolation newInterpolation) noexcept
+{
+    if (newInterpolation != interpolation)
+    {
+        interpolation = newInterpolation;
+        thiranState = {};
+    }
+}
+
+void StereoDelayBuffer::read (const float* delaysL, const float* delaysR,
+                              float* outL, float* outR, int numSamples, int head) noexcept
+{
+    jassert (juce::isPositiveAndBelow (head, maxReadHeads));
+
+    switch (storage)
+    {
+        case DelayStorage::int16:    readWithStorage<Int16Storage> (delaysL, delaysR, outL, outR, numSamples, head); break;
+        case DelayStorage::float16:  readWithStorage<Float16Storage> (delaysL, delaysR, outL, outR, numSamples, head); break;
+        case DelayStorage::float32:
+        default:                     readWithStorage<Float32Storage> (delaysL, delaysR, outL, outR, numSamples, head); break;
+    }
+}
+
+template <typename Storage>
+void StereoDelayBuffer::readWithStorage (const float* delaysL, const float* delaysR,
+                                         float* outL, float* outR, int numSamples, int head) noexcept
+{
+    auto& state = thiranState[(size_t) head];
+
+    switch (interpolation)
+    {
+        case DelayInterpolation::linear:
+            readChannel<Storage, DelayInterpolation::linear> (0, delaysL, outL, numSamples, state[0]);
+            readChannel<Storage, DelayInterpolation::linear> (1, delaysR, outR, numSamples, state[1]);
+            break;
+
+        case DelayInterpolation::hermite:
+            readChannel<Storage, DelayInterpolation::hermite> (0, delaysL, outL, numSamples, state[0]);
+            readChannel<Storage, DelayInterpolation::hermite> (1, delaysR, outR, numSamples, state[1]);
+            break;
+
+        case DelayInterpolation::thiran:
+            readChannel<Storage, DelayInterpolation::thiran> (0, delaysL, outL, numSamples, state[0]);
+            readChannel<Storage, DelayInterpolation::thiran> (1, delaysR, outR, numSamples, state[1]);
+            break;
+
+        case DelayInterpolation::lagrange:
+        default:
+            readChannel<Storage, DelayInterpolation::lagrange> (0, delaysL, outL, numSamples, state[0]);
+            readChannel<Storage, DelayInterpolation::lagrange> (1, delaysR, outR, numSamples, state[1]);
+            break;
+    }
+}
+
+template <typename Storage, DelayInterpolation Type>
+void StereoDelayBuffer::readChannel (int channel, const float* delays, float* out, int numSamples, float& thiranY1) noexcept
+{
+    const typename Storage::Sample* data;
+
+    if constexpr (std::is_same_v<typename Storage::Sample, float>)
+        data = floatBuffer.data() + channel;
+    else
+        data = shortBuffer.data() + channel;
+
+    const auto at = [data, this] (int index) noexcept   { return Storage::load (data[2 * (index & mask)]); };
+
+    float y1 = thiranY1;
+
+    for (int t = 0; t < numSamples; ++t)
+    {
+        const float delay = juce::jlimit (getMinimumDelayForBlock (numSamples), (float) maxDelay, delays[t]);
+        const int now = writePos + t;
+
+        if constexpr (Type == DelayInterpolation::thiran)
+        {
+            // Integer part M and allpass delay in [0.5, 1.5) for a stable, flat response
+            const int M = (int) (delay - 0.5f);
+            const float fraction = delay - (float) M;
+            const float eta = (1.0f - fraction) / (1.0f + fraction);
+
+            const float y = eta * at (now - M) + at (now - M - 1) - eta * y1;
+            y1 = y;
+            out[t] = y;
+        }
+        else
+        {
+            // Position between x0 = x[now - delayInt - 1] and x1 = x[now - delayInt]
+            const int delayInt = (int) delay;
+            const int i = now - delayInt - 1;
+            const float f = 1.0f - (delay - (float) delayInt);
+
+            const float x0 = at (i);
+            const float x1 = at (i + 1);
+
+            if constexpr (Type == DelayInterpolation::linear)
+            {
+                out[t] = x0 + f * (x1 - x0);
+            }
+            else
+            {
+                const float xm1 = at (i - 1);
+                const float x2 = at (i + 2);
+
+                if constexpr (Type == DelayInterpolation::hermite)
+                {
+                    const float c1 = 0.5f * (x1 - xm1);
+                    const float c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+                    const float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+                    out[t] = ((c3 * f + c2) * f + c1) * f + x0;
+                }
+                else
+                {
+                    // Lagrange through the points at -1, 0, 1, 2
+                    const float fp1 = f + 1.0f, fm1 = f - 1.0f, fm2 = f - 2.0f;
+                    out[t] = -xm1 * f * fm1 * fm2 * (1.0f / 6.0f)
+                             + x0 * fp1 * fm1 * fm2 * 0.5f
+                             - x1 * fp1 * f * fm2 * 0.5f
+                             + x2 * fp1 * f * fm1 * (1.0f / 6.0f);
+                }
+            }
+        }
+    }
+
+    thiranY1 = y1;
+}
+
+void StereoDelayBuffer::write (const float* inL, const float* inR, int numSamples) noexcept
+{
+    switch (storage)
+    {
+        case DelayStorage::int16:    writeWithStorage<Int16Storage> (inL, inR, numSamples); break;
+        case DelayStorage::float16:  writeWithStorage<Float16Storage> (inL, inR, numSamples); break;
+        case DelayStorage::float32:
+        default:                     writeWithStorage<Float32Storage> (inL, inR, numSamples); break;
+    }
+}
+
+template <typename Storage>
+void StereoDelayBuffer::writeWithStorage (const float* inL, const float* inR, int numSamples) noexcept
+{
+    typename Storage::Sample* data;
+
+    if constexpr (std::is_same_v<typename Storage::Sample, float>)
+        data = floatBuffer.data();
+    else
+        data = shortBuffer.data();
+
+    auto rng = ditherState;
+
+    for (int t = 0; t < numSamples; ++t)
+    {
+        const int index = 2 * ((writePos + t) & mask);
+        data[index] = Storage::store (inL[t], rng);
+        data[index + 1] = Storage::store (inR[t], rng);
+    }
+
+    ditherState = rng;
+    writePos = (writePos + numSamples) & mask;
+}
+
+void StereoDelayBuffer::writeSilence (int numSamples) noexcept
+{
+    const int capacity = mask + 1;
+    const int first = juce::jmin (numSamples, capacity - writePos);
+
+    if (storage == DelayStorage::float32)
+    {
+        std::fill_n (floatBuffer.data() + 2 * writePos, 2 * first, 0.0f);
+        std::fill_n (floatBuffer.data(), 2 * (numSamples - first), 0.0f);
+    }
+    else
+    {
+        std::fill_n (shortBuffer.data() + 2 * writePos, 2 * first, (int16_t) 0);
+        std::fill_n (shortBuffer.data(), 2 * (numSamples - first), (int16_t) 0);
+    }
+
+    writePos = (writePos + numSamples) & mask;
+}
@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+  ==============================================================================
+*/
+
+#include "UnderwaterStage.h"
+
+void UnderwaterStage::prepare (const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = (float) spec.sampleRate;
+    coefficientTable = coefficientTables->getUnderwater (spec.sampleRate);
+
+    juce::dsp::ProcessSpec monoSpec { spec.sampleRate, spec.maximumBlockSize, 1 };
+    modDelayL.prepare (monoSpec);
+    modDelayR.prepare (monoSpec);
+
+    interleaved.prepare ((int) spec.maximumBlockSize);
+    modOscillator.prepare (interleaved.getCapacity());
+    modOscillatorRate = 0.0f;
+    amountSmoothed.prepare (spec.sampleRate, 0.02, interleaved.getCapacity());
+    mixSmoothed.prepare (spec.sampleRate, 0.05, interleaved.getCapacity());   // Longer ramp for bypass
+    reset();
+}
+
+void UnderwaterStage::reset()
+{
+    filters.reset();
+    updateFilter (amountSmoothed.getCurrentValue(), true);
+
+    modDelayL.reset();
+    modDelayR.reset();
+    modOscillator.setPhase (0, 0.0f);
+}
+
+void UnderwaterStage::setEnabled (bool shouldBeEnabled, bool immediately)
+{
+    if (immediately)
+        mixSmoothed.setCurrentAndTargetValue (shouldBeEnabled ? 1.0f : 0.0f);
+    else
+        mixSmoothed.setTargetValue (shouldBeEnabled ? 1.0f : 0.0f);
+}
+
+void UnderwaterStage::updateFilter (float amount, bool immediately) noexcept
+{
+    if (coefficientTable == nullptr)
+        return;
+
+    const auto c = coefficientTable->lookup (0, amount);
+    filterAmount = amount;
+
+    if (immediately)
+    {
+        filters.setSection (0, c.main);
+        filters.setSection (1, c.resonance);
+        filters.setSection (2, c.warmth);
+    }
+    else
+    {
+        filters.setTargetSection (0, c.main);
+        filters.setTargetSection (1, c.resonance);
+        filters.setTargetSection (2, c.warmth);
+    }
+}
+
+void UnderwaterStage::process (const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    jassert (block.getNumChannels() >= 2);
+
+    const int numSamples = (int) block.getNumSamples();
+    auto* left = block.getChannelPointer (0);
+    auto* right = block.getChannelPointer (1);
+
+    // Fully bypassed or fully dry for the whole block
+    if ((! mixSmoothed.isSmoothing() && mixSmoothed.getCurrentValue() <= 0.001f)
+     || (! amountSmoothed.isSmoothing() && amountSmoothed.getCurrentValue() <= 0.001f))
+    {
+        mixSmoothed.skip (numSamples);
+        amountSmoothed.skip (numSamples);
+        activity.reset();
+        return;
+    }
+
+    // Silent for longer than the ring-out: the output is silent too
+    if (activity.isIdle (block, [this] { return ringOutSeconds * sampleRate; }))
+    {
+        mixSmoothed.skip (numSamples);
+        amountSmoothed.skip (numSamples);
+        return;
+    }
+
+    for (int start = 0; start < numSamples; start += interleaved.getCapacity())
+    {
+        const int num = juce::jmin (numSamples - start, interleaved.getCapacity());
+        processChunk (left + start, right + start, num);
+    }
+}
+
+void UnderwaterStage::processChunk (float* left, float* right, int numSamples) noexcept
+{
+    // The ramps feed both the filter modulation and the mix
+    const bool isRamping = amountSmoothed.isSmoothing() || mixSmoothed.isSmoothing();
+    const float* amountRamp = isRamping ? amountSmoothed.processRamp (numSamples) : nullptr;
+    const float* mixRamp = isRamping ? mixSmoothed.processRamp (numSamples) : nullptr;
+
+    // Main filtering, one pass through the fused cascade
+    const float* channels[] = { left, right };
+    interleaved.pack (channels, 2, numSamples);
+    filterChunk (amountRamp, numSamples);
+
+    // Chorus LFO, 0.3-0.7 Hz with the amount at the end of the chunk
+    const float modRate = 0.3f + (amountRamp != nullptr ? amountRamp[numSamples - 1]
+                                                        : amountSmoothed.getCurrentValue()) * 0.4f;
+
+    if (modRate != modOscillatorRate)
+    {
+        modOscillator.setFrequency (0, modRate, sampleRate);
+        modOscillatorRate = modRate;
+    }
+
+    modOscillator.process (numSamples);
+
+    if (isRamping)
+        mixChunk<true> (left, right, amountRamp, mixRamp, numSamples);
+    else
+        mixChunk<false> (left, right, nullptr, nullptr, numSamples);
+}
+
+void UnderwaterStage::filterChunk (const float* amountRamp, int numSamples) noexcept
+{
+    // Steady amount: one design (if any) and a plain pass
+    if (amountRamp == nullptr)
+    {
+        if (amountSmoothed.getCurrentValue() != filterAmount)
+            updateFilter (amountSmoothed.getCurrentValue(), false);
+
+        filters.process (interleaved.get(), numSamples);
+        return;
+    }
+
+    for (int start = 0; start < numSamples; start += controlInterval)
+    {
+        const int num = juce::jmin (numSamples - start, controlInterval);
+        const float amount = amountRamp[start + num - 1];
+
+        if (amount != filterAmount)
+            updateFilter (amount, false);
+
+        filters.process (interleaved.get() + start, num);
+    }
+}
+
+template <bool IsRamping>
+void UnderwaterStage::mixChunk (float* left, float* right, const float* amountRamp,
+                                const float* mixRamp, int numSamples) noexcept
+{
+    const float sr = sampleRate;
+    const float* modSin = modOscillator.getSin (0);
+    const float* modCos = modOscillator.getCos (0);
+    const float offsetCos = std::cos (rightPhaseOffset);
+    const float offsetSin = std::sin (rightPhaseOffset);
+
+    // Steady: process() already skipped fully dry blocks, so every sample is wet
+    float uwAmt = amountSmoothed.getCurrentValue();
+    float uwMix = mixSmoothed.getCurrentValue();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if constexpr (IsRamping)
+        {
+            uwAmt = amountRamp[i];
+            uwMix = mixRamp[i];
+
+            if (uwMix <= 0.001f || uwAmt <= 0.001f)
+                continue;
+        }
+
+        float inL = left[i];
+        float inR = right[i];
+
+        float uwL = interleaved.getSample (0, i);
+        float uwR = interleaved.getSample (1, i);
+
+        // Modulated delay for movement and stereo width
+        float modDepth = 1.5f + uwAmt * 2.5f;  // 1.5-4ms
+        float modDepthSamples = modDepth * sr / 1000.0f;
+
+        // R runs rightPhaseOffset ahead of L for width: sin (x + d) = sin x cos d + cos x sin d
+        float modL = modSin[i] * modDepthSamples;
+        float modR = (modSin[i] * offsetCos + modCos[i] * offsetSin) * modDepthSamples;
+
+        modDelayL.pushSample (0, uwL);
+        modDelayR.pushSample (0, uwR);
+
+        float delayedL = modDelayL.popSample (0, 10.0f + modL);
+        float delayedR = modDelayR.popSample (0, 10.0f + modR);
+
+        // Blend modulated with direct
+        float modMix = 0.3f + uwAmt * 0.4f;
+        uwL = uwL * (1.0f - modMix) + delayedL * modMix;
+        uwR = uwR * (1.0f - modMix) + delayedR * modMix;
+
+        // Subtle stereo widening
+        float mid = (uwL + uwR) * 0.5f;
+        float side = (uwL - uwR) * 0.5f;
+        side *= 1.0f + uwAmt * 0.3f;
+        uwL = mid + side;
+        uwR = mid - side;
+
+        // Crossfade: dry->underwater based on amount, then bypass crossfade
+        uwL = inL * (1.0f - uwAmt) + uwL * uwAmt;
+        uwR = inR * (1.0f - uwAmt) + uwR * uwAmt;
+
+        left[i] = inL * (1.0f - uwMix) + uwL * uwMix;
+        right[i] = inR * (1.0f - uwMix) + uwR * uwMix;
+    }
+}
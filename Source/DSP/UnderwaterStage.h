@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    UNDERWATER - spacey, wide, warm modulated filtering
+    The filter follows the smoothed amount: it is looked up in the shared
+    coefficient table every controlInterval samples and its SVF
+    coefficients are interpolated linearly in between, so sweeps and
+    automation never zipper.
+  ==============================================================================
+*/
+
+#pragma once
+#include "FilterCoefficientTables.h"
+#include "SIMDSVF.h"
+#include "BlockSmoother.h"
+#include "OscillatorBank.h"
+#include "StageActivity.h"
+
+class UnderwaterStage
+{
+public:
+    void prepare (const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    void setAmount (float amount01)                          { amountSmoothed.setTargetValue (amount01); }
+    void setEnabled (bool shouldBeEnabled, bool immediately = false);
+
+    // Stereo block, processed in place
+    void process (const juce::dsp::AudioBlock<float>& block) noexcept;
+
+private:
+    void processChunk (float* left, float* right, int numSamples) noexcept;
+
+    // Filter, redesigned from the amount at the end of each control period
+    void filterChunk (const float* amountRamp, int numSamples) noexcept;
+    void updateFilter (float amount, bool immediately) noexcept;
+
+    // Modulation and dry/wet mix; the steady variant has no per-sample checks
+    template <bool IsRamping>
+    void mixChunk (float* left, float* right, const float* amountRamp, const float* mixRamp, int numSamples) noexcept;
+
+    static constexpr int controlInterval = 32;
+
+    // main -> resonance -> warmth, L/R in SIMD lanes
+    SIMDSVFCascade<3> filters;
+    SIMDInterleavedBuffer interleaved;
+    float filterAmount = 0.0f;   // amount the filter was last designed for
+
+    juce::SharedResourcePointer<FilterCoefficientTables> coefficientTables;
+    std::shared_ptr<const FilterCoefficientTables::UnderwaterTable> coefficientTable;   // at sampleRate
+
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> modDelayL { 4800 };
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> modDelayR { 4800 };
+    OscillatorBank<1> modOscillator;   // L phase; R is derived from it
+    float modOscillatorRate = 0.0f;
+    static constexpr float rightPhaseOffset = 1.83f;
+
+    BlockSmoother<> amountSmoothed;
+    BlockSmoother<> mixSmoothed;
+
+    StageActivity activity;
+    static constexpr double ringOutSeconds = 0.1;   // mod delay (up to 14 ms) and resonant filters
+
+    float sampleRate = 44100.0f;
+};
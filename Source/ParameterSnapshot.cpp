@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+  ==============================================================================
+*/
+
+#include "ParameterSnapshot.h"
+
+ParameterSnapshotSource::ParameterSnapshotSource (juce::AudioProcessorValueTreeState& apvts,
+                                                  const std::atomic<float>& cableHumAmount)
+{
+    // Same order as Params::Index up to cableHum
+    static const char* const ids[] =
+    {
+        "phone", "phoneBypass", "phoneMode", "phoneCodec",
+        "delayFeedback", "delayMix", "delayBypass", "delayPingPong", "delaySync",
+        "delayInterpolation", "delayEngine", "delayStorage", "delayTaps",
+        "saturation", "saturationBypass", "saturationOversampling", "saturationCurveTable", "antiAliasing",
+        "underwater", "underwaterBypass",
+        "outputGain", "outputBypass"
+    };
+
+    static_assert (std::size (ids) == Params::cableHum, "one id per APVTS slot");
+
+    for (int i = 0; i < Params::cableHum; ++i)
+        sources[(size_t) i] = apvts.getRawParameterValue (ids[i]);
+
+    sources[Params::cableHum] = &cableHumAmount;
+
+    for (int tap = 0; tap < EchoStage::maxTaps; ++tap)
+    {
+        const juce::String id ("delayTap" + juce::String (tap + 1));
+
+        sources[(size_t) Params::tapTime (tap)]     = apvts.getRawParameterValue (tap == 0 ? juce::String ("delayTime") : id + "Time");
+        sources[(size_t) Params::tapDivision (tap)] = apvts.getRawParameterValue (tap == 0 ? juce::String ("delayDivision") : id + "Division");
+        sources[(size_t) Params::tapLevel (tap)]    = apvts.getRawParameterValue (id + "Level");
+        sources[(size_t) Params::tapPan (tap)]      = apvts.getRawParameterValue (id + "Pan");
+    }
+
+    for (auto* source : sources)
+        jassert (source != nullptr);
+
+    // NaN never compares equal, so the first update() reports every parameter
+    snapshot.values.fill (std::numeric_limits<float>::quiet_NaN());
+}
+
+const ParameterSnapshot& ParameterSnapshotSource::update() noexcept
+{
+    uint64_t changed = 0;
+
+    for (int i = 0; i < Params::count; ++i)
+    {
+        const float value = sources[(size_t) i]->load (std::memory_order_relaxed);
+
+        if (value != snapshot.values[(size_t) i])
+        {
+            snapshot.values[(size_t) i] = value;
+            changed |= Params::bit (i);
+        }
+    }
+
+    snapshot.changed = changed;
+    return snapshot;
+}
@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    Parameter snapshot for the audio thread.
+    ParameterSnapshotSource looks every parameter up once at construction and
+    keeps the std::atomic<float>* pointers. update() loads them all into a
+    plain ParameterSnapshot once per block, together with a bitmask of what
+    changed since the previous block, so processBlock does no string lookups
+    and can skip setters and redesigns for untouched controls.
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "DSP/EchoStage.h"
+
+namespace Params
+{
+    enum Index : int
+    {
+        phone = 0,
+        phoneBypass,
+        phoneMode,
+        phoneCodec,
+
+        delayFeedback,
+        delayMix,
+        delayBypass,
+        delayPingPong,
+        delaySync,
+        delayInterpolation,
+        delayEngine,
+        delayStorage,
+        delayTaps,
+
+        saturation,
+        saturationBypass,
+        saturationOversampling,
+        saturationCurveTable,
+        antiAliasing,
+
+        underwater,
+        underwaterBypass,
+
+        outputGain,
+        outputBypass,
+
+        cableHum,   // set from the editor, not an APVTS parameter
+
+        // Time, division, level, pan per echo tap. Tap 0's time and
+        // division are the main delayTime / delayDivision.
+        firstTap,
+        count = firstTap + 4 * EchoStage::maxTaps
+    };
+
+    constexpr int tapTime (int tap) noexcept       { return firstTap + 4 * tap; }
+    constexpr int tapDivision (int tap) noexcept   { return firstTap + 4 * tap + 1; }
+    constexpr int tapLevel (int tap) noexcept      { return firstTap + 4 * tap + 2; }
+    constexpr int tapPan (int tap) noexcept        { return firstTap + 4 * tap + 3; }
+
+    constexpr uint64_t bit (int index) noexcept    { return uint64_t (1) << index; }
+
+    constexpr uint64_t tapBits() noexcept
+    {
+        uint64_t mask = 0;
+
+        for (int i = firstTap; i < count; ++i)
+            mask |= bit (i);
+
+        return mask;
+    }
+
+    static_assert (count <= 64, "the changed mask holds one bit per parameter");
+}
+
+struct ParameterSnapshot
+{
+    std::array<float, Params::count> values {};
+    uint64_t changed = 0;   // bit i: values[i] differs from the previous snapshot
+
+    float get (int index) const noexcept                 { return values[(size_t) index]; }
+    int getInt (int index) const noexcept                { return static_cast<int> (values[(size_t) index]); }
+    bool getBool (int index) const noexcept              { return values[(size_t) index] > 0.5f; }
+
+    bool hasChanged (int index) const noexcept           { return (changed & Params::bit (index)) != 0; }
+    bool anyChanged (uint64_t mask) const noexcept       { return (changed & mask) != 0; }
+};
+
+class ParameterSnapshotSource
+{
+public:
+    ParameterSnapshotSource (juce::AudioProcessorValueTreeState& apvts, const std::atomic<float>& cableHumAmount);
+
+    // Audio thread: loads every parameter once. The first call flags everything as changed.
+    const ParameterSnapshot& update() noexcept;
+
+    // Any thread: one parameter straight from its atomic
+    float load (int index) const noexcept                { return sources[(size_t) index]->load(); }
+
+private:
+    std::array<const std::atomic<float>*, Params::count> sources {};
+    ParameterSnapshot snapshot;
+
+    JUCE_DECLARE_NON_COPYABLE (ParameterSnapshotSource)
+};
@@ -26,34 +26,16 @@ HoneyVoxAudioProcessor::HoneyVoxAudioProcessor()
      : AudioProcessor (BusesProperties()
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-       apvts (*this, nullptr, "Parameters", createParameterLayout())
+       apvts (*this, nullptr, "Parameters", createParameterLayout()),
+       parameters (apvts, cableHumAmount)
 {
-    // Register parameter listeners for smooth bypass transitions
-    apvts.addParameterListener ("phoneBypass", this);
-    apvts.addParameterListener ("delayBypass", this);
-    apvts.addParameterListener ("saturationBypass", this);
-    apvts.addParameterListener ("underwaterBypass", this);
+    startTimerHz (tailPollRateHz);
 }
 
 HoneyVoxAudioProcessor::~HoneyVoxAudioProcessor()
 {
-    apvts.removeParameterListener ("phoneBypass", this);
-    apvts.removeParameterListener ("delayBypass", this);
-    apvts.removeParameterListener ("saturationBypass", this);
-    apvts.removeParameterListener ("underwaterBypass", this);
-}
-
-void HoneyVoxAudioProcessor::parameterChanged (const juce::String& parameterID, float newValue)
-{
-    // Smooth bypass transitions
-    if (parameterID == "phoneBypass")
-        phoneMixSmoothed.setTargetValue (newValue < 0.5f ? 1.0f : 0.0f);
-    else if (parameterID == "delayBypass")
-        delayBypassMix.setTargetValue (newValue < 0.5f ? 1.0f : 0.0f);
-    else if (parameterID == "saturationBypass")
-        satMixSmoothed.setTargetValue (newValue < 0.5f ? 1.0f : 0.0f);
-    else if (parameterID == "underwaterBypass")
-        uwMixSmoothed.setTargetValue (newValue < 0.5f ? 1.0f : 0.0f);
+    stopTimer();
+    cancelPendingUpdate();
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout HoneyVoxAudioProcessor::createParameterLayout()
@@ -68,6 +50,8 @@ juce::AudioProcessorValueTreeState::ParameterLayout HoneyVoxAudioProcessor::crea
     params.push_back (std::make_unique<juce::AudioParameterChoice>(
         juce::ParameterID("phoneMode", 1), "Phone Mode", 
         juce::StringArray { "Rotary", "Touch-Tone", "Mobile" }, 0));
+    params.push_back (std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID("phoneCodec", 1), "Mobile GSM Codec", false));
     
     // Delay effect - TIME can be ms or synced
     params.push_back (std::make_unique<juce::AudioParameterFloat>(
@@ -83,16 +67,61 @@ juce::AudioProcessorValueTreeState::ParameterLayout HoneyVoxAudioProcessor::crea
         juce::ParameterID("delayPingPong", 1), "Ping-Pong", false));
     params.push_back (std::make_unique<juce::AudioParameterBool>(
         juce::ParameterID("delaySync", 1), "Delay Sync", false));
+    const juce::StringArray divisions { "1/1", "1/2", "1/2 D", "1/2 T", "1/4", "1/4 D", "1/4 T", 
+                                        "1/8", "1/8 D", "1/8 T", "1/16", "1/16 D", "1/16 T" };
+    params.push_back (std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("delayDivision", 1), "Delay Division", divisions, 4));
     params.push_back (std::make_unique<juce::AudioParameterChoice>(
-        juce::ParameterID("delayDivision", 1), "Delay Division",
-        juce::StringArray { "1/1", "1/2", "1/2 D", "1/2 T", "1/4", "1/4 D", "1/4 T", 
-                           "1/8", "1/8 D", "1/8 T", "1/16", "1/16 D", "1/16 T" }, 4));
+        juce::ParameterID("delayInterpolation", 1), "Delay Interpolation",
+        juce::StringArray { "Linear", "Hermite", "Lagrange", "Thiran" }, 2));
+    params.push_back (std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("delayEngine", 1), "Delay Engine",
+        juce::StringArray { "Clean", "Vintage 1/2", "Vintage 1/4" }, 0));
+    params.push_back (std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("delayStorage", 1), "Delay Storage",
+        juce::StringArray { "32-bit Float", "16-bit Integer", "16-bit Half Float" }, 0));
+    
+    // Multi-tap: tap 1 is the main delay above, taps 2-8 bring their own time
+    params.push_back (std::make_unique<juce::AudioParameterInt>(
+        juce::ParameterID("delayTaps", 1), "Delay Taps", 1, EchoStage::maxTaps, 1));
+    
+    for (int tap = 1; tap <= EchoStage::maxTaps; ++tap)
+    {
+        const juce::String id ("delayTap" + juce::String (tap));
+        const juce::String name ("Tap " + juce::String (tap));
+        
+        if (tap > 1)
+        {
+            // Defaults spread the taps out: 375, 500, 750 ms... / 1/4 D, 1/2, 1/2 D...
+            static constexpr float defaultTimes[] { 375.0f, 500.0f, 750.0f, 1000.0f, 1250.0f, 1500.0f, 2000.0f };
+            static constexpr int defaultDivisions[] { 5, 1, 2, 0, 0, 0, 0 };
+            
+            params.push_back (std::make_unique<juce::AudioParameterFloat>(
+                juce::ParameterID(id + "Time", 1), name + " Time",
+                juce::NormalisableRange<float>(50.0f, 2000.0f, 1.0f, 0.4f), defaultTimes[tap - 2]));
+            params.push_back (std::make_unique<juce::AudioParameterChoice>(
+                juce::ParameterID(id + "Division", 1), name + " Division", divisions, defaultDivisions[tap - 2]));
+        }
+        
+        params.push_back (std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(id + "Level", 1), name + " Level", 0.0f, 100.0f, tap == 1 ? 100.0f : 80.0f - 8.0f * (float) tap));
+        params.push_back (std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(id + "Pan", 1), name + " Pan", -100.0f, 100.0f,
+            tap == 1 ? 0.0f : (tap % 2 == 0 ? -50.0f : 50.0f)));
+    }
     
     // Saturation (Honey)
     params.push_back (std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID("saturation", 1), "Honey", 0.0f, 100.0f, 25.0f));
     params.push_back (std::make_unique<juce::AudioParameterBool>(
         juce::ParameterID("saturationBypass", 1), "Saturation Bypass", true));
+    params.push_back (std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID("saturationOversampling", 1), "Honey Oversampling",
+        juce::StringArray { "1x", "2x", "4x", "8x" }, 0));
+    params.push_back (std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID("saturationCurveTable", 1), "Honey Curve Table", false));
+    params.push_back (std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID("antiAliasing", 1), "Anti-Aliasing", false));
     
     // Underwater effect
     params.push_back (std::make_unique<juce::AudioParameterFloat>(
@@ -137,7 +166,7 @@ const juce::String HoneyVoxAudioProcessor::getName() const { return JucePlugin_N
 bool HoneyVoxAudioProcessor::acceptsMidi() const { return false; }
 bool HoneyVoxAudioProcessor::producesMidi() const { return false; }
 bool HoneyVoxAudioProcessor::isMidiEffect() const { return false; }
-double HoneyVoxAudioProcessor::getTailLengthSeconds() const { return 2.0; }
+double HoneyVoxAudioProcessor::getTailLengthSeconds() const { return reportedTailSeconds.load(); }
 int HoneyVoxAudioProcessor::getNumPrograms() { return 1; }
 int HoneyVoxAudioProcessor::getCurrentProgram() { return 0; }
 void HoneyVoxAudioProcessor::setCurrentProgram (int) {}
@@ -150,61 +179,134 @@ void HoneyVoxAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
     
     juce::dsp::ProcessSpec spec;
     spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
+    spec.maximumBlockSize = static_cast<juce::uint32>(internalBlockSize);  // never the host's size
     spec.numChannels = 2;
+    currentSpec = spec;
+    
+    honeyStage.prepare (spec);
+    phoneStage.prepare (spec);
+    underwaterStage.prepare (spec);
+    echoStage.setRateDivider (getRequestedEchoRateDivider());
+    echoStage.setStorage (getRequestedEchoStorage());
+    echoStage.prepare (spec);
+    humStage.prepare (spec);
+    outputStage.prepare (spec);
+    
+    juce::ignoreUnused (samplesPerBlock);
+    fifo.prepare (internalBlockSize);
+    tempoChangePending = false;
+    
+    dryDelay.prepare (internalBlockSize + honeyStage.getMaxLatencySamples() + phoneStage.getMaxLatencySamples());
+    resumeDry.setSize (2, internalBlockSize);
+    wasBypassed = false;
+    resumeSamplesLeft = 0;
+    
+    // Initialize bypass states (no fade on load)
+    phoneStage.setEnabled (parameters.load (Params::phoneBypass) < 0.5f, true);
+    echoStage.setEnabled (parameters.load (Params::delayBypass) < 0.5f, true);
+    honeyStage.setEnabled (parameters.load (Params::saturationBypass) < 0.5f, true);
+    underwaterStage.setEnabled (parameters.load (Params::underwaterBypass) < 0.5f, true);
+    
+    // Delay feedback filters for the new sample rate (phone and underwater
+    // design their own at control rate)
+    coefficientEngine.prepare();
+    coefficientEngine.updateDelayFeedback (echoStage.getInternalSampleRate());
+    echoStage.setCoefficients (coefficientEngine.getDelayFeedback());
+    
+    honeyStage.setOversamplingOrder (static_cast<int>(parameters.load (Params::saturationOversampling)));
+    phoneStage.setCodecEnabled (parameters.load (Params::phoneCodec) > 0.5f);
+    updateLatency();
+}
+
+int HoneyVoxAudioProcessor::getRequestedEchoRateDivider() const
+{
+    // Clean, Vintage 1/2, Vintage 1/4
+    const int engine = static_cast<int>(parameters.load (Params::delayEngine));
+    return 1 << juce::jlimit (0, 2, engine);
+}
+
+DelayStorage HoneyVoxAudioProcessor::getRequestedEchoStorage() const
+{
+    const int storage = static_cast<int>(parameters.load (Params::delayStorage));
+    return static_cast<DelayStorage>(juce::jlimit (0, 2, storage));
+}
+
+bool HoneyVoxAudioProcessor::echoEngineNeedsPrepare() const
+{
+    return getRequestedEchoRateDivider() != echoStage.getRateDivider()
+        || getRequestedEchoStorage() != echoStage.getStorage();
+}
+
+void HoneyVoxAudioProcessor::prepareEchoEngine()
+{
+    echoStage.setRateDivider (getRequestedEchoRateDivider());
+    echoStage.setStorage (getRequestedEchoStorage());
+    echoStage.prepare (currentSpec);
+    echoStage.setEnabled (parameters.load (Params::delayBypass) < 0.5f, true);
     
-    // Reset all filters
-    phonePreEmphasisL.reset(); phonePreEmphasisR.reset();
-    phoneHighpassL.reset(); phoneHighpassR.reset();
-    phoneLowpassL.reset(); phoneLowpassR.reset();
-    phoneMidBoostL.reset(); phoneMidBoostR.reset();
-    phoneWarmthL.reset(); phoneWarmthR.reset();
-    phonePostFilterL.reset(); phonePostFilterR.reset();
-    
-    delayLineL.reset(); delayLineR.reset();
-    delayLineL.prepare(spec); delayLineR.prepare(spec);
-    delayFeedbackHiCutL.reset(); delayFeedbackHiCutR.reset();
-    delayFeedbackLoCutL.reset(); delayFeedbackLoCutR.reset();
-    delayDampingL.reset(); delayDampingR.reset();
-    feedbackL = 0.0f; feedbackR = 0.0f;
-    
-    uwMainFilterL.reset(); uwMainFilterR.reset();
-    uwResonanceL.reset(); uwResonanceR.reset();
-    uwWarmthL.reset(); uwWarmthR.reset();
-    uwModDelayL.reset(); uwModDelayR.reset();
-    uwModDelayL.prepare(spec); uwModDelayR.prepare(spec);
-    
-    satDcBlockL = 0.0f; satDcBlockR = 0.0f;
-    
-    // Initialize smoothed values with longer ramp for bypass (50ms)
-    float bypassRampTime = 0.05f;
-    float paramRampTime = 0.02f;
-    
-    phoneAmountSmoothed.reset(sampleRate, paramRampTime);
-    phoneMixSmoothed.reset(sampleRate, bypassRampTime);
-    delayTimeSmoothed.reset(sampleRate, 0.1f);  // Longer for pitch stability
-    delayFeedbackSmoothed.reset(sampleRate, paramRampTime);
-    delayMixSmoothed.reset(sampleRate, paramRampTime);
-    delayBypassMix.reset(sampleRate, bypassRampTime);
-    saturationAmountSmoothed.reset(sampleRate, paramRampTime);
-    satMixSmoothed.reset(sampleRate, bypassRampTime);
-    underwaterAmountSmoothed.reset(sampleRate, paramRampTime);
-    uwMixSmoothed.reset(sampleRate, bypassRampTime);
-    outputGainSmoothed.reset(sampleRate, paramRampTime);
-    
-    // Initialize bypass states
-    phoneMixSmoothed.setCurrentAndTargetValue(apvts.getRawParameterValue("phoneBypass")->load() < 0.5f ? 1.0f : 0.0f);
-    delayBypassMix.setCurrentAndTargetValue(apvts.getRawParameterValue("delayBypass")->load() < 0.5f ? 1.0f : 0.0f);
-    satMixSmoothed.setCurrentAndTargetValue(apvts.getRawParameterValue("saturationBypass")->load() < 0.5f ? 1.0f : 0.0f);
-    uwMixSmoothed.setCurrentAndTargetValue(apvts.getRawParameterValue("underwaterBypass")->load() < 0.5f ? 1.0f : 0.0f);
-    
-    // Delay feedback filters - warm analog-style rolloff
-    delayFeedbackHiCutL.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, 4500.0f, 0.6f);
-    delayFeedbackHiCutR.coefficients = delayFeedbackHiCutL.coefficients;
-    delayFeedbackLoCutL.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, 80.0f, 0.7f);
-    delayFeedbackLoCutR.coefficients = delayFeedbackLoCutL.coefficients;
-    delayDampingL.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sampleRate, 1000.0f, 0.7f, 0.85f);
-    delayDampingR.coefficients = delayDampingL.coefficients;
+    if (coefficientEngine.updateDelayFeedback (echoStage.getInternalSampleRate()))
+        echoStage.setCoefficients (coefficientEngine.getDelayFeedback());
+}
+
+void HoneyVoxAudioProcessor::handleAsyncUpdate()
+{
+    if (echoEngineNeedsPrepare())
+    {
+        suspendProcessing (true);
+        prepareEchoEngine();
+        suspendProcessing (false);
+    }
+}
+
+void HoneyVoxAudioProcessor::updateLatency()
+{
+    // Stages run in series, so their latencies add up, plus one internal block for the FIFO
+    const int latency = internalBlockSize + honeyStage.getLatencySamples() + phoneStage.getLatencySamples();
+    
+    if (latency != getLatencySamples())
+        setLatencySamples (latency);
+}
+
+void HoneyVoxAudioProcessor::updateTailLength() noexcept
+{
+    // Hum never stops; otherwise the echo decay plus the other stages' ring-out
+    const double tail = humStage.isGenerating() ? std::numeric_limits<double>::infinity()
+                                                : echoStage.getTailSeconds() + stageRingOutSeconds;
+    currentTailSeconds.store (tail, std::memory_order_relaxed);
+}
+
+double HoneyVoxAudioProcessor::roundUpTail (double seconds) noexcept
+{
+    if (! std::isfinite (seconds))
+        return seconds;
+    
+    // 0.25 s steps up to 2 s, then the step doubles with every doubling of
+    // the length (between a sixteenth and an eighth of it)
+    const double step = tailStepSeconds * std::exp2 (std::floor (std::log2 (juce::jmax (1.0, seconds / 2.0))));
+    return std::ceil (seconds / step) * step;
+}
+
+void HoneyVoxAudioProcessor::timerCallback()
+{
+    // Hosts that ask get the current value straight away
+    const double tail = roundUpTail (currentTailSeconds.load (std::memory_order_relaxed));
+    reportedTailSeconds.store (tail);
+    
+    // A longer tail is announced as soon as it can be, a shorter one only
+    // once it has dropped by a quarter, so small moves around a step don't bounce
+    if (! (tail > notifiedTailSeconds || tail < notifiedTailSeconds * 0.75))
+        return;
+    
+    // There is no tail flag in ChangeDetails. The latency flag gets the tail
+    // re-read in some hosts, but VST3 hosts that honour it deactivate and
+    // re-prepare the plugin, which clears the echo. So only while the echo
+    // is asleep, with its input silent for the whole tail and nothing left
+    // ringing.
+    if (! echoIsAsleep.load (std::memory_order_relaxed))
+        return;
+    
+    notifiedTailSeconds = tail;
+    updateHostDisplay (juce::AudioProcessor::ChangeDetails{}.withLatencyChanged (true));
 }
 
 void HoneyVoxAudioProcessor::releaseResources() {}
@@ -226,8 +328,10 @@ void HoneyVoxAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
     auto totalNumOutputChannels = getTotalNumOutputChannels();
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
-
+    
     // Get tempo from host
+    const double previousBPM = currentBPM;
+    
     if (auto* hostPlayHead = getPlayHead())
     {
         auto posInfo = hostPlayHead->getPosition();
@@ -238,430 +342,166 @@ void HoneyVoxAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
         }
     }
     
-    // === GET ALL PARAMETERS ===
-    float phoneVal = apvts.getRawParameterValue("phone")->load();
-    int phoneMode = static_cast<int>(apvts.getRawParameterValue("phoneMode")->load());
-    
-    float delayTimeVal = apvts.getRawParameterValue("delayTime")->load();
-    float delayFeedbackVal = apvts.getRawParameterValue("delayFeedback")->load();
-    float delayMixVal = apvts.getRawParameterValue("delayMix")->load();
-    bool pingPong = apvts.getRawParameterValue("delayPingPong")->load() > 0.5f;
-    bool delaySync = apvts.getRawParameterValue("delaySync")->load() > 0.5f;
-    int delayDivision = static_cast<int>(apvts.getRawParameterValue("delayDivision")->load());
-    
-    float satVal = apvts.getRawParameterValue("saturation")->load();
-    float uwVal = apvts.getRawParameterValue("underwater")->load();
+    if (currentBPM != previousBPM)
+        tempoChangePending = true;
     
-    float outputGainDb = apvts.getRawParameterValue("outputGain")->load();
-    bool outputOn = apvts.getRawParameterValue("outputBypass")->load() < 0.5f;
-    float outputGain = outputOn ? juce::Decibels::decibelsToGain(outputGainDb) : 1.0f;
-    
-    // Calculate delay time (synced or ms)
-    float actualDelayMs = delaySync ? divisionToMs(delayDivision, currentBPM) : delayTimeVal;
-    actualDelayMs = juce::jlimit(20.0f, 2000.0f, actualDelayMs);
-    
-    // Set parameter targets
-    phoneAmountSmoothed.setTargetValue(phoneVal / 100.0f);
-    delayTimeSmoothed.setTargetValue(actualDelayMs);
-    delayFeedbackSmoothed.setTargetValue(delayFeedbackVal / 100.0f * 0.92f);  // Cap at 92% for stability
-    delayMixSmoothed.setTargetValue(delayMixVal / 100.0f);
-    saturationAmountSmoothed.setTargetValue(satVal / 100.0f);
-    underwaterAmountSmoothed.setTargetValue(uwVal / 100.0f);
-    outputGainSmoothed.setTargetValue(outputGain);
-    
-    // === UPDATE PHONE FILTERS based on mode ===
-    float phoneIntensity = phoneVal / 100.0f;
+    // Back from host bypass: the FIFO still holds audio from before it
+    if (std::exchange (wasBypassed, false))
+    {
+        fifo.reset();
+        resumeSamplesLeft = getLatencySamples() + resumeFadeSamples;
+    }
     
-    // WARM phone filter parameters - less harsh, more musical
-    float hpFreq, lpFreq, midFreq, midQ, midGainDb, warmthGain;
+    // === FIXED INTERNAL BLOCKS ===
+    // Each FIFO slot hands back the processed sample from the previous
+    // internal block and takes the new input; a full FIFO is processed in
+    // place with a fresh parameter snapshot
+    const int numSamples = buffer.getNumSamples();
+    auto* hostL = buffer.getWritePointer (0);
+    auto* hostR = buffer.getNumChannels() < 2 ? nullptr : buffer.getWritePointer (1);
     
-    switch (phoneMode)
+    const auto processInternalBlock = [this] (const juce::dsp::AudioBlock<float>& block)
     {
-        case 0: // ROTARY (1920s-1950s) - Warm, lo-fi, carbon mic character
-            hpFreq = 350.0f + phoneIntensity * 250.0f;    // Gentle bass cut (350-600 Hz)
-            lpFreq = 2800.0f - phoneIntensity * 800.0f;   // Rounded highs (2000-2800 Hz)
-            midFreq = 900.0f;                              // Lower, warmer peak
-            midQ = 1.5f + phoneIntensity * 2.0f;          // Moderate resonance (1.5-3.5)
-            midGainDb = 3.0f + phoneIntensity * 5.0f;     // Gentle boost (+3 to +8 dB)
-            warmthGain = 1.5f + phoneIntensity * 1.5f;    // Add low warmth
-            break;
-            
-        case 1: // TOUCH-TONE (1960s-1980s) - Clear but band-limited
-            hpFreq = 280.0f + phoneIntensity * 120.0f;    // Light bass cut (280-400 Hz)
-            lpFreq = 3600.0f - phoneIntensity * 600.0f;   // Clearer highs (3000-3600 Hz)
-            midFreq = 1400.0f;                             // Presence
-            midQ = 1.2f + phoneIntensity * 1.0f;          // Gentle (1.2-2.2)
-            midGainDb = 2.0f + phoneIntensity * 3.0f;     // Subtle (+2 to +5 dB)
-            warmthGain = 1.2f + phoneIntensity * 0.8f;    // Slight warmth
-            break;
-            
-        case 2: // MOBILE (1990s-2000s) - Digital but musical, not harsh
-            hpFreq = 200.0f + phoneIntensity * 200.0f;    // Moderate bass (200-400 Hz)
-            lpFreq = 4200.0f - phoneIntensity * 1000.0f;  // More bandwidth (3200-4200 Hz)
-            midFreq = 2000.0f;                             // Higher presence
-            midQ = 2.0f + phoneIntensity * 2.5f;          // Tighter (2.0-4.5)
-            midGainDb = 3.0f + phoneIntensity * 4.0f;     // Moderate (+3 to +7 dB)
-            warmthGain = 1.0f + phoneIntensity * 0.5f;    // Less warmth (digital)
-            break;
-            
-        default:
-            hpFreq = 300.0f; lpFreq = 3400.0f; midFreq = 1200.0f; midQ = 1.5f; 
-            midGainDb = 3.0f; warmthGain = 1.2f;
-    }
+        applyParameters (std::exchange (tempoChangePending, false));
+        processStages (block);
+    };
     
-    // Set phone filter coefficients - WARM versions
-    float hpQ = 0.5f + phoneIntensity * 0.3f;  // Gentler slope
-    float lpQ = 0.5f + phoneIntensity * 0.3f;
-    
-    phoneHighpassL.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass(currentSampleRate, hpFreq, hpQ);
-    phoneHighpassR.coefficients = phoneHighpassL.coefficients;
-    phoneLowpassL.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(currentSampleRate, lpFreq, lpQ);
-    phoneLowpassR.coefficients = phoneLowpassL.coefficients;
-    
-    float midGainLinear = juce::Decibels::decibelsToGain(midGainDb);
-    phoneMidBoostL.coefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(currentSampleRate, midFreq, midQ, midGainLinear);
-    phoneMidBoostR.coefficients = phoneMidBoostL.coefficients;
-    
-    // Warmth: low shelf boost
-    phoneWarmthL.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(currentSampleRate, 300.0f, 0.7f, warmthGain);
-    phoneWarmthR.coefficients = phoneWarmthL.coefficients;
-    
-    // Post filter: gentle smoothing to remove harshness
-    float postFreq = lpFreq * 1.1f;
-    phonePostFilterL.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(currentSampleRate, postFreq, 0.5f);
-    phonePostFilterR.coefficients = phonePostFilterL.coefficients;
-    
-    // === UPDATE UNDERWATER FILTERS ===
-    float uwIntensity = uwVal / 100.0f;
-    float uwCutoff = 6000.0f * std::pow(0.08f, uwIntensity);  // Less extreme
-    uwCutoff = std::max(uwCutoff, 300.0f);
-    float uwQ = 0.6f + uwIntensity * 0.8f;  // Gentler resonance
-    
-    uwMainFilterL.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(currentSampleRate, uwCutoff, uwQ);
-    uwMainFilterR.coefficients = uwMainFilterL.coefficients;
-    
-    // Resonance for "bubble" character
-    float resFreq = uwCutoff * 0.7f;
-    float resQ = 1.0f + uwIntensity * 1.5f;
-    float resGain = juce::Decibels::decibelsToGain(2.0f * uwIntensity);
-    uwResonanceL.coefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(currentSampleRate, resFreq, resQ, resGain);
-    uwResonanceR.coefficients = uwResonanceL.coefficients;
-    
-    // Warmth shelf
-    float uwWarmthGain = 1.0f + uwIntensity * 0.8f;
-    uwWarmthL.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(currentSampleRate, 400.0f, 0.6f, uwWarmthGain);
-    uwWarmthR.coefficients = uwWarmthL.coefficients;
-    
-    // === PROCESS SAMPLES ===
-    auto* leftChannel = buffer.getWritePointer(0);
-    auto* rightChannel = buffer.getNumChannels() > 1 ? buffer.getWritePointer(1) : nullptr;
-    const float twoPi = juce::MathConstants<float>::twoPi;
-    const float sr = static_cast<float>(currentSampleRate);
-    
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+    // Back from bypass, the delayed dry signal covers whatever the FIFO and
+    // the stages' delays hand back from before it, then fades out, a chunk
+    // at a time (the dry scratch is one internal block long)
+    auto* dryL = resumeDry.getWritePointer (0);
+    auto* dryR = resumeDry.getWritePointer (1);
+    
+    for (int start = 0; start < numSamples;)
     {
-        // Get smoothed values
-        float phoneAmt = phoneAmountSmoothed.getNextValue();
-        float phoneMix = phoneMixSmoothed.getNextValue();
-        float delayTime = delayTimeSmoothed.getNextValue();
-        float delayFb = delayFeedbackSmoothed.getNextValue();
-        float delayMix = delayMixSmoothed.getNextValue();
-        float delayActive = delayBypassMix.getNextValue();
-        float satAmt = saturationAmountSmoothed.getNextValue();
-        float satMix = satMixSmoothed.getNextValue();
-        float uwAmt = underwaterAmountSmoothed.getNextValue();
-        float uwMix = uwMixSmoothed.getNextValue();
-        float outGain = outputGainSmoothed.getNextValue();
-        
-        float inL = leftChannel[sample];
-        float inR = rightChannel ? rightChannel[sample] : inL;
-        
-        // Store dry signal for mixing
-        float dryL = inL;
-        float dryR = inR;
-        
-        // ============================================================
-        // 1. SATURATION (Honey) - HG-2 inspired warm saturation
-        // ============================================================
-        float satL = inL;
-        float satR = inR;
+        auto* left = hostL + start;
+        auto* right = hostR != nullptr ? hostR + start : nullptr;
         
-        if (satMix > 0.001f && satAmt > 0.001f)
+        if (resumeSamplesLeft == 0)
         {
-            // Input gain staging
-            float inputGain = 1.0f + satAmt * 1.5f;
-            satL *= inputGain;
-            satR *= inputGain;
-            
-            // Stage 1: Tube-style warmth (even harmonics)
-            // Soft asymmetric curve that adds 2nd harmonic
-            float tubeDrive = 0.8f + satAmt * 0.4f;
-            satL = satL * tubeDrive / (1.0f + std::abs(satL * tubeDrive) * 0.3f);
-            satR = satR * tubeDrive / (1.0f + std::abs(satR * tubeDrive) * 0.3f);
-            
-            // Add subtle 2nd harmonic (even)
-            satL += std::abs(satL) * satL * 0.15f * satAmt;
-            satR += std::abs(satR) * satR * 0.15f * satAmt;
-            
-            // Stage 2: Tape-style saturation (odd harmonics, compression)
-            float tapeDrive = 1.0f + satAmt * 0.8f;
-            satL = std::tanh(satL * tapeDrive) / tapeDrive;
-            satR = std::tanh(satR * tapeDrive) / tapeDrive;
-            
-            // Stage 3: Transformer coloration (subtle)
-            float xfmrAmt = satAmt * 0.3f;
-            satL = satL * (1.0f - xfmrAmt) + std::tanh(satL * 1.2f) * xfmrAmt;
-            satR = satR * (1.0f - xfmrAmt) + std::tanh(satR * 1.2f) * xfmrAmt;
-            
-            // DC blocking (simple high-pass)
-            float dcCoeff = 0.995f;
-            satDcBlockL = satL - satDcBlockL * dcCoeff + satDcBlockL;
-            float dcFreeL = satL - satDcBlockL;
-            satDcBlockR = satR - satDcBlockR * dcCoeff + satDcBlockR;
-            float dcFreeR = satR - satDcBlockR;
-            satL = dcFreeL;
-            satR = dcFreeR;
-            
-            // Output gain compensation (louder input = less makeup)
-            float makeupGain = 1.0f / (1.0f + satAmt * 0.4f);
-            satL *= makeupGain;
-            satR *= makeupGain;
-            
-            // Mix with dry based on satMix (bypass crossfade)
-            inL = dryL * (1.0f - satMix) + satL * satMix;
-            inR = dryR * (1.0f - satMix) + satR * satMix;
-        }
-        
-        // ============================================================
-        // 2. PHONE FILTER - warm vintage phone character
-        // ============================================================
-        float phoneL = inL;
-        float phoneR = inR;
-        
-        if (phoneMix > 0.001f && phoneAmt > 0.001f)
-        {
-            // Multi-stage filtering with warmth
-            phoneL = phoneHighpassL.processSample(phoneL);
-            phoneL = phoneMidBoostL.processSample(phoneL);
-            phoneL = phoneWarmthL.processSample(phoneL);
-            phoneL = phoneLowpassL.processSample(phoneL);
-            phoneL = phonePostFilterL.processSample(phoneL);
-            
-            phoneR = phoneHighpassR.processSample(phoneR);
-            phoneR = phoneMidBoostR.processSample(phoneR);
-            phoneR = phoneWarmthR.processSample(phoneR);
-            phoneR = phoneLowpassR.processSample(phoneR);
-            phoneR = phonePostFilterR.processSample(phoneR);
-            
-            // Gentle saturation for character (mode-dependent)
-            if (phoneMode == 0)  // Rotary - warm tube-like
-            {
-                phoneL = phoneL / (1.0f + std::abs(phoneL) * 0.2f * phoneAmt);
-                phoneR = phoneR / (1.0f + std::abs(phoneR) * 0.2f * phoneAmt);
-            }
-            else if (phoneMode == 2)  // Mobile - subtle digital compression
-            {
-                float comp = 1.0f + phoneAmt * 0.3f;
-                phoneL = std::tanh(phoneL * comp) / comp;
-                phoneR = std::tanh(phoneR * comp) / comp;
-            }
-            
-            // Crossfade: dry->phone based on amount, then bypass crossfade
-            float phoneWet = phoneAmt;
-            phoneL = inL * (1.0f - phoneWet) + phoneL * phoneWet;
-            phoneR = inR * (1.0f - phoneWet) + phoneR * phoneWet;
-            
-            // Bypass crossfade
-            inL = inL * (1.0f - phoneMix) + phoneL * phoneMix;
-            inR = inR * (1.0f - phoneMix) + phoneR * phoneMix;
+            dryDelay.write (left, right, numSamples - start);
+            fifo.process (left, right, numSamples - start, processInternalBlock);
+            break;
         }
         
-        // ============================================================
-        // 3. UNDERWATER - spacey, wide, warm
-        // ============================================================
-        float uwL = inL;
-        float uwR = inR;
+        const int num = juce::jmin (numSamples - start, internalBlockSize);
+        juce::FloatVectorOperations::copy (dryL, left, num);
         
-        if (uwMix > 0.001f && uwAmt > 0.001f)
-        {
-            // Main filtering
-            uwL = uwMainFilterL.processSample(uwL);
-            uwL = uwResonanceL.processSample(uwL);
-            uwL = uwWarmthL.processSample(uwL);
-            
-            uwR = uwMainFilterR.processSample(uwR);
-            uwR = uwResonanceR.processSample(uwR);
-            uwR = uwWarmthR.processSample(uwR);
-            
-            // Modulated delay for movement and stereo width
-            float modRate = 0.3f + uwAmt * 0.4f;  // 0.3-0.7 Hz
-            float modDepth = 1.5f + uwAmt * 2.5f;  // 1.5-4ms
-            float modDepthSamples = modDepth * sr / 1000.0f;
-            
-            uwModPhaseL += modRate * twoPi / sr;
-            uwModPhaseR += modRate * twoPi / sr;
-            if (uwModPhaseL > twoPi) uwModPhaseL -= twoPi;
-            if (uwModPhaseR > twoPi) uwModPhaseR -= twoPi;
-            
-            float modL = std::sin(uwModPhaseL) * modDepthSamples;
-            float modR = std::sin(uwModPhaseR + 1.5f) * modDepthSamples;  // Phase offset for width
-            
-            uwModDelayL.pushSample(0, uwL);
-            uwModDelayR.pushSample(0, uwR);
-            
-            float delayedL = uwModDelayL.popSample(0, 10.0f + modL);
-            float delayedR = uwModDelayR.popSample(0, 10.0f + modR);
-            
-            // Blend modulated with direct
-            float modMix = 0.3f + uwAmt * 0.4f;
-            uwL = uwL * (1.0f - modMix) + delayedL * modMix;
-            uwR = uwR * (1.0f - modMix) + delayedR * modMix;
-            
-            // Subtle stereo widening
-            float mid = (uwL + uwR) * 0.5f;
-            float side = (uwL - uwR) * 0.5f;
-            side *= 1.0f + uwAmt * 0.3f;
-            uwL = mid + side;
-            uwR = mid - side;
-            
-            // Crossfade
-            float uwWet = uwAmt;
-            uwL = inL * (1.0f - uwWet) + uwL * uwWet;
-            uwR = inR * (1.0f - uwWet) + uwR * uwWet;
-            
-            // Bypass crossfade
-            inL = inL * (1.0f - uwMix) + uwL * uwMix;
-            inR = inR * (1.0f - uwMix) + uwR * uwMix;
-        }
+        if (right != nullptr)
+            juce::FloatVectorOperations::copy (dryR, right, num);
         
-        // ============================================================
-        // 4. DELAY (Echo) - H-Delay style with proper ping-pong
-        // ============================================================
-        float delayOutL = 0.0f;
-        float delayOutR = 0.0f;
+        dryDelay.process (dryL, right != nullptr ? dryR : nullptr, num, getLatencySamples());
+        fifo.process (left, right, num, processInternalBlock);
         
-        if (delayActive > 0.001f && delayMix > 0.001f)
+        for (int i = 0; i < num && resumeSamplesLeft > 0; ++i, --resumeSamplesLeft)
         {
-            float delaySamples = (delayTime / 1000.0f) * sr;
-            
-            // Subtle modulation for organic feel
-            delayModPhase += 0.6f * twoPi / sr;
-            if (delayModPhase > twoPi) delayModPhase -= twoPi;
-            float mod = std::sin(delayModPhase) * 0.3f * sr / 1000.0f;
-            
-            if (pingPong)
-            {
-                // TRUE PING-PONG: L->R->L->R alternating
-                // Read from delay lines
-                float tapL = delayLineL.popSample(0, delaySamples + mod);
-                float tapR = delayLineR.popSample(0, delaySamples - mod * 0.5f);
-                
-                // Filter the feedback (analog-style degradation)
-                tapL = delayFeedbackHiCutL.processSample(tapL);
-                tapL = delayFeedbackLoCutL.processSample(tapL);
-                tapL = delayDampingL.processSample(tapL);
-                
-                tapR = delayFeedbackHiCutR.processSample(tapR);
-                tapR = delayFeedbackLoCutR.processSample(tapR);
-                tapR = delayDampingR.processSample(tapR);
-                
-                // Soft saturation in feedback
-                tapL = std::tanh(tapL * 1.1f) / 1.1f;
-                tapR = std::tanh(tapR * 1.1f) / 1.1f;
-                
-                // Ping-pong routing:
-                // Left delay receives: mono input + feedback from RIGHT
-                // Right delay receives: feedback from LEFT only
-                float monoIn = (inL + inR) * 0.5f;
-                
-                delayLineL.pushSample(0, monoIn + tapR * delayFb);
-                delayLineR.pushSample(0, tapL * delayFb);
-                
-                delayOutL = tapL;
-                delayOutR = tapR;
-            }
-            else
-            {
-                // Standard stereo delay
-                float tapL = delayLineL.popSample(0, delaySamples + mod);
-                float tapR = delayLineR.popSample(0, delaySamples - mod * 0.5f);
-                
-                tapL = delayFeedbackHiCutL.processSample(tapL);
-                tapL = delayFeedbackLoCutL.processSample(tapL);
-                tapL = delayDampingL.processSample(tapL);
-                
-                tapR = delayFeedbackHiCutR.processSample(tapR);
-                tapR = delayFeedbackLoCutR.processSample(tapR);
-                tapR = delayDampingR.processSample(tapR);
-                
-                tapL = std::tanh(tapL * 1.1f) / 1.1f;
-                tapR = std::tanh(tapR * 1.1f) / 1.1f;
-                
-                delayLineL.pushSample(0, inL + tapL * delayFb);
-                delayLineR.pushSample(0, inR + tapR * delayFb);
-                
-                delayOutL = tapL;
-                delayOutR = tapR;
-            }
+            const float wet = juce::jlimit (0.0f, 1.0f, 1.0f - (float) resumeSamplesLeft / (float) resumeFadeSamples);
+            left[i] = dryL[i] + wet * (left[i] - dryL[i]);
             
-            // Mix delay with dry (delayMix controls wet amount)
-            float wetL = delayOutL * delayMix;
-            float wetR = delayOutR * delayMix;
-            
-            // Bypass crossfade
-            inL = inL + wetL * delayActive;
-            inR = inR + wetR * delayActive;
-        }
-        else
-        {
-            // Still push to delay lines to prevent artifacts when re-enabled
-            delayLineL.pushSample(0, 0.0f);
-            delayLineR.pushSample(0, 0.0f);
+            if (right != nullptr)
+                right[i] = dryR[i] + wet * (right[i] - dryR[i]);
         }
         
-        // ============================================================
-        // 5. CABLE HUM (subtle vintage warmth from easter egg screw)
-        // ============================================================
-        float humAmount = cableHumAmount.load();
-        if (humAmount > 0.001f)
+        start += num;
+    }
+}
+
+void HoneyVoxAudioProcessor::processBlockBypassed (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ignoreUnused (midiMessages);
+    juce::ScopedNoDenormals noDenormals;
+    
+    for (auto i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+    
+    // The dry signal, as late as the processed one would be. Its history was
+    // recorded while processing, so nothing drops out when bypass engages.
+    wasBypassed = true;
+    resumeSamplesLeft = 0;
+    dryDelay.process (buffer.getWritePointer (0),
+                      buffer.getNumChannels() < 2 ? nullptr : buffer.getWritePointer (1),
+                      buffer.getNumSamples(), getLatencySamples());
+}
+
+void HoneyVoxAudioProcessor::applyParameters (bool tempoChanged)
+{
+    // === GET ALL PARAMETERS (one load each, plus what changed) ===
+    const auto& p = parameters.update();
+    
+    float phoneVal = p.get (Params::phone);
+    int phoneMode = p.getInt (Params::phoneMode);
+    float uwVal = p.get (Params::underwater);
+    bool delaySync = p.getBool (Params::delaySync);
+    
+    // Bypass crossfades
+    if (p.hasChanged (Params::phoneBypass))       phoneStage.setEnabled (! p.getBool (Params::phoneBypass));
+    if (p.hasChanged (Params::delayBypass))       echoStage.setEnabled (! p.getBool (Params::delayBypass));
+    if (p.hasChanged (Params::saturationBypass))  honeyStage.setEnabled (! p.getBool (Params::saturationBypass));
+    if (p.hasChanged (Params::underwaterBypass))  underwaterStage.setEnabled (! p.getBool (Params::underwaterBypass));
+    
+    // Set parameter targets
+    honeyStage.setAmount (p.get (Params::saturation) / 100.0f);
+    
+    if (p.anyChanged (Params::bit (Params::saturationOversampling) | Params::bit (Params::phoneCodec)))
+    {
+        honeyStage.setOversamplingOrder (p.getInt (Params::saturationOversampling));
+        phoneStage.setCodecEnabled (p.getBool (Params::phoneCodec));
+        updateLatency();
+    }
+    
+    honeyStage.setAntiAliasing (p.getBool (Params::antiAliasing));
+    honeyStage.setUseCurveTable (p.getBool (Params::saturationCurveTable));
+    
+    phoneStage.setMode (phoneMode);
+    phoneStage.setAmount (phoneVal / 100.0f);
+    
+    underwaterStage.setAmount (uwVal / 100.0f);
+    
+    echoStage.setFeedback (p.get (Params::delayFeedback) / 100.0f * 0.92f);  // Cap at 92% for stability
+    echoStage.setMix (p.get (Params::delayMix) / 100.0f);
+    echoStage.setPingPong (p.getBool (Params::delayPingPong));
+    echoStage.setInterpolation (static_cast<DelayInterpolation>(p.getInt (Params::delayInterpolation)));
+    echoStage.setNumTaps (p.getInt (Params::delayTaps));
+    
+    // Tap 0 is the main delay; all taps follow its sync switch (synced or ms)
+    if (p.anyChanged (Params::tapBits() | Params::bit (Params::delaySync))
+        || (delaySync && tempoChanged))
+    {
+        for (int tap = 0; tap < EchoStage::maxTaps; ++tap)
         {
-            // 60Hz fundamental + harmonics for authentic hum
-            float hum60 = std::sin(cableHumPhase) * 0.4f;
-            float hum120 = std::sin(cableHumPhase * 2.0f) * 0.25f;
-            float hum180 = std::sin(cableHumPhase * 3.0f) * 0.1f;
-            
-            // Slight random flutter for vintage character
-            float flutter = std::sin(cableHumPhase2) * 0.15f;
-            
-            float humSignal = (hum60 + hum120 + hum180) * (1.0f + flutter);
-            humSignal *= humAmount * 0.008f;  // Very subtle - max 0.8% of signal
-            
-            inL += humSignal;
-            inR += humSignal * 0.95f;  // Slight stereo difference
-            
-            // Advance phases
-            cableHumPhase += 2.0f * juce::MathConstants<float>::pi * 60.0f / (float)currentSampleRate;
-            if (cableHumPhase > juce::MathConstants<float>::twoPi)
-                cableHumPhase -= juce::MathConstants<float>::twoPi;
-            
-            cableHumPhase2 += 2.0f * juce::MathConstants<float>::pi * 0.3f / (float)currentSampleRate;
-            if (cableHumPhase2 > juce::MathConstants<float>::twoPi)
-                cableHumPhase2 -= juce::MathConstants<float>::twoPi;
+            float tapMs = delaySync ? divisionToMs (p.getInt (Params::tapDivision (tap)), currentBPM)
+                                    : p.get (Params::tapTime (tap));
+            echoStage.setTapTimeMs (tap, juce::jlimit (20.0f, EchoStage::maxDelayTimeMs, tapMs));
+            echoStage.setTapLevel (tap, p.get (Params::tapLevel (tap)) / 100.0f);
+            echoStage.setTapPan (tap, p.get (Params::tapPan (tap)) / 100.0f);
         }
-        
-        // ============================================================
-        // 6. OUTPUT GAIN
-        // ============================================================
-        inL *= outGain;
-        inR *= outGain;
-        
-        // Gentle final limiting
-        inL = std::tanh(inL * 0.9f) / 0.9f;
-        inR = std::tanh(inR * 0.9f) / 0.9f;
-        
-        leftChannel[sample] = inL;
-        if (rightChannel) rightChannel[sample] = inR;
     }
+    
+    // Engine and storage changes reallocate the echo buffers, hand them to the message thread
+    if (p.anyChanged (Params::bit (Params::delayEngine) | Params::bit (Params::delayStorage))
+        && echoEngineNeedsPrepare())
+        triggerAsyncUpdate();
+    
+    bool outputOn = ! p.getBool (Params::outputBypass);
+    float outputGain = outputOn ? juce::Decibels::decibelsToGain (p.get (Params::outputGain)) : 1.0f;
+    
+    humStage.setAmount (p.get (Params::cableHum));
+    outputStage.setGain (outputGain);
+    outputStage.setAntiAliasing (p.getBool (Params::antiAliasing));
+    
+    updateTailLength();
+}
+
+void HoneyVoxAudioProcessor::processStages (const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    honeyStage.process (block);        // 1. SATURATION (Honey)
+    phoneStage.process (block);        // 2. PHONE FILTER
+    underwaterStage.process (block);   // 3. UNDERWATER
+    echoStage.process (block);         // 4. DELAY (Echo)
+    humStage.process (block);          // 5. CABLE HUM
+    outputStage.process (block);       // 6. OUTPUT GAIN + limiter
+    
+    echoIsAsleep.store (echoStage.isAsleep(), std::memory_order_relaxed);
 }
 
 bool HoneyVoxAudioProcessor::hasEditor() const { return true; }
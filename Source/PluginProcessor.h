@@ -9,9 +9,18 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "DSP/HoneyStage.h"
+#include "DSP/PhoneStage.h"
+#include "DSP/UnderwaterStage.h"
+#include "DSP/EchoStage.h"
+#include "DSP/HumStage.h"
+#include "DSP/OutputStage.h"
+#include "DSP/FixedBlockFifo.h"
+#include "ParameterSnapshot.h"
 
 class HoneyVoxAudioProcessor : public juce::AudioProcessor,
-                                public juce::AudioProcessorValueTreeState::Listener
+                                private juce::AsyncUpdater,
+                                private juce::Timer
 {
 public:
     HoneyVoxAudioProcessor();
@@ -21,6 +30,7 @@ public:
     void releaseResources() override;
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlockBypassed (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override;
@@ -40,71 +50,91 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
     
-    void parameterChanged (const juce::String& parameterID, float newValue) override;
-    
     juce::AudioProcessorValueTreeState apvts;
     
 private:
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     
-    // === PHONE FILTERS - warm multi-stage ===
-    juce::dsp::IIR::Filter<float> phonePreEmphasisL, phonePreEmphasisR;
-    juce::dsp::IIR::Filter<float> phoneHighpassL, phoneHighpassR;
-    juce::dsp::IIR::Filter<float> phoneLowpassL, phoneLowpassR;
-    juce::dsp::IIR::Filter<float> phoneMidBoostL, phoneMidBoostR;
-    juce::dsp::IIR::Filter<float> phoneWarmthL, phoneWarmthR;
-    juce::dsp::IIR::Filter<float> phonePostFilterL, phonePostFilterR;
-    
-    // === DELAY - H-Delay style with proper ping-pong ===
-    static constexpr int maxDelaySamples = 192000;
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> delayLineL{maxDelaySamples};
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> delayLineR{maxDelaySamples};
-    
-    juce::dsp::IIR::Filter<float> delayFeedbackHiCutL, delayFeedbackHiCutR;
-    juce::dsp::IIR::Filter<float> delayFeedbackLoCutL, delayFeedbackLoCutR;
-    juce::dsp::IIR::Filter<float> delayDampingL, delayDampingR;
-    
-    float feedbackL = 0.0f, feedbackR = 0.0f;
-    
-    // === SATURATION - HG-2 inspired ===
-    float satDcBlockL = 0.0f, satDcBlockR = 0.0f;
-    
-    // === UNDERWATER - spacey, wide, warm ===
-    juce::dsp::IIR::Filter<float> uwMainFilterL, uwMainFilterR;
-    juce::dsp::IIR::Filter<float> uwResonanceL, uwResonanceR;
-    juce::dsp::IIR::Filter<float> uwWarmthL, uwWarmthR;
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> uwModDelayL{4800};
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> uwModDelayR{4800};
-    float uwModPhaseL = 0.0f, uwModPhaseR = 0.33f;
-    
-    // === SMOOTHED PARAMETERS ===
-    juce::SmoothedValue<float> phoneAmountSmoothed;
-    juce::SmoothedValue<float> phoneMixSmoothed;
-    juce::SmoothedValue<float> delayTimeSmoothed;
-    juce::SmoothedValue<float> delayFeedbackSmoothed;
-    juce::SmoothedValue<float> delayMixSmoothed;
-    juce::SmoothedValue<float> delayBypassMix;
-    juce::SmoothedValue<float> saturationAmountSmoothed;
-    juce::SmoothedValue<float> satMixSmoothed;
-    juce::SmoothedValue<float> underwaterAmountSmoothed;
-    juce::SmoothedValue<float> uwMixSmoothed;
-    juce::SmoothedValue<float> outputGainSmoothed;
-    juce::SmoothedValue<float> cableHumSmoothed;
-    
-    float delayModPhase = 0.0f;
+    // === DSP STAGES (in signal flow order) ===
+    HoneyStage honeyStage;
+    PhoneStage phoneStage;
+    UnderwaterStage underwaterStage;
+    EchoStage echoStage;
+    HumStage humStage;
+    OutputStage outputStage;
+    
+    // === COEFFICIENTS - designed off the heap, only on change ===
+    FilterCoefficientEngine coefficientEngine;
+    
+    // === FIXED INTERNAL BLOCKS ===
+    // The stages only ever see whole blocks of internalBlockSize samples,
+    // taken from a FIFO allocated in prepareToPlay (always stereo, mono
+    // layouts feed L to both sides). Chunking never follows the host's
+    // buffer size, so neither does the output, and every stage is prepared
+    // for exactly this block size. The FIFO stays in even when the host's
+    // blocks are multiples of 64: hosts may split a block anywhere (automation,
+    // loop points), and the latency has to stay put when they do.
+    static constexpr int internalBlockSize = 64;
+    FixedBlockFifo fifo;
+    bool tempoChangePending = false;
+    
+    // === HOST BYPASS ===
+    // The dry input is always recorded, so bypass outputs it delayed by the
+    // reported latency from its first sample and the track doesn't shift
+    // against the others. On resume the FIFO starts empty and the delayed dry
+    // signal carries on until new input has come through the latency, then
+    // crossfades into the processed output over resumeFadeSamples.
+    DryDelay dryDelay;
+    juce::AudioBuffer<float> resumeDry;
+    bool wasBypassed = false;
+    int resumeSamplesLeft = 0;
+    static constexpr int resumeFadeSamples = 256;
+    
     double currentBPM = 120.0;
     double currentSampleRate = 44100.0;
     
-    // Cable hum oscillator
-    float cableHumPhase = 0.0f;
-    float cableHumPhase2 = 0.0f;
-    
     float divisionToMs (int division, double bpm) const;
+    void processStages (const juce::dsp::AudioBlock<float>& block) noexcept;
+    
+    // Fresh parameter snapshot before each internal block
+    void applyParameters (bool tempoChanged);
+    void updateLatency();
+    
+    // === TAIL LENGTH ===
+    // Worked out on the audio thread after every parameter snapshot, from the
+    // echo loop and the hum, and only stored there. timerCallback polls it a
+    // few times a second on the message thread and rounds it up (coarser
+    // steps for longer tails) for getTailLengthSeconds. The host is notified
+    // when the rounded value grows or drops by a quarter, but only while the
+    // echo is asleep, since the notification can re-prepare the plugin.
+    void updateTailLength() noexcept;
+    void timerCallback() override;
+    static double roundUpTail (double seconds) noexcept;
+    static constexpr double stageRingOutSeconds = 0.25;   // honey, phone, underwater, limiter
+    static constexpr double tailStepSeconds = 0.25;       // finest step, up to 2 s
+    static constexpr int tailPollRateHz = 4;
+    std::atomic<double> currentTailSeconds { 2.0 };       // audio thread
+    std::atomic<double> reportedTailSeconds { 2.0 };      // getTailLengthSeconds
+    std::atomic<bool> echoIsAsleep { false };             // audio thread, after each block
+    double notifiedTailSeconds = 2.0;                     // message thread
+    
+    // Settings that need reallocation are applied on the message thread
+    // with processing suspended (see handleAsyncUpdate)
+    void handleAsyncUpdate() override;
+    void prepareEchoEngine();
+    int getRequestedEchoRateDivider() const;
+    DelayStorage getRequestedEchoStorage() const;
+    bool echoEngineNeedsPrepare() const;
+    
+    juce::dsp::ProcessSpec currentSpec { 44100.0, 512, 2 };
     
 public:
     // Cable hum amount (set from editor)
     std::atomic<float> cableHumAmount { 0.0f };
     
 private:
+    // Cached parameter pointers, read into one snapshot per block
+    ParameterSnapshotSource parameters;
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HoneyVoxAudioProcessor)
 };
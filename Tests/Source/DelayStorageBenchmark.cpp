@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    StereoDelayBuffer storage formats side by side: memory for the echo's
+    longest delay at 48 kHz, and the cost of writing a block and reading it
+    back through all eight heads at spread-out delays (so reads miss the
+    cache the way long multi-tap echoes do). Run with --benchmarks.
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DSP/StereoDelayBuffer.h"
+#include "DSP/EchoStage.h"
+
+class DelayStorageBenchmark : public juce::UnitTest
+{
+public:
+    DelayStorageBenchmark() : juce::UnitTest ("Delay storage", "Benchmarks") {}
+
+    void runTest() override
+    {
+        const std::pair<DelayStorage, const char*> formats[] = { { DelayStorage::float32, "float32" },
+                                                                  { DelayStorage::int16,   "int16" },
+                                                                  { DelayStorage::float16, "float16" } };
+        size_t floatBytes = 0;
+
+        for (const auto& format : formats)
+        {
+            beginTest (format.second);
+
+            StereoDelayBuffer buffer;
+            buffer.prepare (maxDelaySamples, blockSize, format.first);
+            const auto bytes = buffer.getMemoryBytes();
+
+            if (format.first == DelayStorage::float32)
+                floatBytes = bytes;
+
+            logMessage ("memory " + juce::String ((double) bytes / 1024.0, 1) + " KiB per instance");
+
+            for (const auto interpolation : { DelayInterpolation::linear, DelayInterpolation::hermite })
+            {
+                buffer.setInterpolation (interpolation);
+                logMessage (juce::String (interpolation == DelayInterpolation::linear ? "linear" : "hermite")
+                            + ": " + juce::String (measure (buffer), 2) + " ns per sample (write + 8 heads)");
+            }
+
+            if (format.first != DelayStorage::float32)
+                expectEquals ((juce::int64) bytes * 2, (juce::int64) floatBytes, "half the float32 memory");
+        }
+    }
+
+private:
+    static constexpr int blockSize = 64;
+    static constexpr int numBlocks = 20000;
+    static constexpr int maxDelaySamples = (int) (EchoStage::maxDelayTimeMs * 48) + 1;
+
+    static double measure (StereoDelayBuffer& buffer)
+    {
+        buffer.reset();
+
+        std::vector<float> inL ((size_t) blockSize), inR ((size_t) blockSize);
+        std::vector<float> outL ((size_t) blockSize), outR ((size_t) blockSize);
+        std::vector<std::vector<float>> delays;
+
+        // Heads from 1/8 to all of the range, a fraction off the integer
+        for (int head = 0; head < StereoDelayBuffer::maxReadHeads; ++head)
+            delays.emplace_back ((size_t) blockSize, (float) (maxDelaySamples - 4) * (float) (head + 1) / 8.0f - 0.37f);
+
+        for (int i = 0; i < blockSize; ++i)
+        {
+            inL[(size_t) i] = 0.5f * (float) std::sin (0.05 * i);
+            inR[(size_t) i] = 0.5f * (float) std::cos (0.05 * i);
+        }
+
+        float sink = 0.0f;
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (int head = 0; head < StereoDelayBuffer::maxReadHeads; ++head)
+            {
+                const auto* d = delays[(size_t) head].data();
+                buffer.read (d, d, outL.data(), outR.data(), blockSize, head);
+                sink += outL[0] + outR[(size_t) blockSize - 1];
+            }
+
+            buffer.write (inL.data(), inR.data(), blockSize);
+        }
+
+        const double elapsed = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - startTicks);
+        juce::ignoreUnused (sink);
+        return 1.0e9 * elapsed / ((double) numBlocks * blockSize);
+    }
+};
+
+static DelayStorageBenchmark delayStorageBenchmark;
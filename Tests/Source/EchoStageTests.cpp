@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    EchoStage loop stability: with every tap at full level and the feedback
+    at its 92 % cap, an impulse must still die away, on every engine and in
+    ping-pong, and be gone once the reported tail has run out (when the
+    stage reports itself asleep).
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DSP/EchoStage.h"
+#include "DSP/FilterCoefficientEngine.h"
+
+class EchoStageTests : public juce::UnitTest
+{
+public:
+    EchoStageTests() : juce::UnitTest ("EchoStage", "HoneyVox") {}
+
+    void runTest() override
+    {
+        for (const int divider : { 1, 2, 4 })
+        {
+            for (const bool pingPong : { false, true })
+            {
+                beginTest ("8 taps at full level and max feedback decay, divider " + juce::String (divider)
+                           + (pingPong ? ", ping-pong" : ""));
+                checkImpulseDecays (divider, pingPong);
+            }
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 64;
+    static constexpr float maxFeedback = 0.92f;   // the processor's stability cap
+
+    void checkImpulseDecays (int divider, bool pingPong)
+    {
+        EchoStage echo;
+        echo.setRateDivider (divider);
+        echo.prepare ({ sampleRate, (juce::uint32) blockSize, 2 });
+
+        FilterCoefficientEngine coefficients;
+        coefficients.prepare();
+        coefficients.updateDelayFeedback (echo.getInternalSampleRate());
+        echo.setCoefficients (coefficients.getDelayFeedback());
+
+        echo.setEnabled (true, true);
+        echo.setMix (1.0f);
+        echo.setFeedback (maxFeedback);
+        echo.setPingPong (pingPong);
+        echo.setNumTaps (EchoStage::maxTaps);
+
+        for (int k = 0; k < EchoStage::maxTaps; ++k)
+        {
+            echo.setTapTimeMs (k, 60.0f + 25.0f * (float) k);
+            echo.setTapLevel (k, 1.0f);
+            echo.setTapPan (k, 0.0f);
+        }
+
+        // Let the smoothers reach their targets before the impulse (silence in, silence out)
+        std::vector<float> left ((size_t) blockSize), right ((size_t) blockSize);
+        const int settleBlocks = (int) (sampleRate / blockSize);
+
+        for (int b = 0; b < settleBlocks; ++b)
+            processBlock (echo, left, right);
+
+        const double tailSeconds = echo.getTailSeconds();
+        logMessage ("reported tail " + juce::String (tailSeconds, 2) + " s");
+        expect (std::isfinite (tailSeconds) && tailSeconds < 60.0, "finite tail");
+
+        // Peak of each second from the impulse on (the first one holds the dry impulse)
+        const int secondsToRun = (int) std::ceil (juce::jmin (tailSeconds, 60.0)) + 1;
+        const int blocksPerSecond = (int) (sampleRate / blockSize);
+        std::vector<float> peaks;
+
+        for (int second = 0; second < secondsToRun; ++second)
+        {
+            float peak = 0.0f;
+
+            for (int b = 0; b < blocksPerSecond; ++b)
+            {
+                std::fill (left.begin(), left.end(), 0.0f);
+                std::fill (right.begin(), right.end(), 0.0f);
+
+                if (second == 0 && b == 0)
+                    left[0] = right[0] = 1.0f;
+
+                processBlock (echo, left, right);
+
+                if (second == 0 && b == 0)
+                    expect (! echo.isAsleep(), "awake with signal in");
+
+                for (int i = 0; i < blockSize; ++i)
+                    peak = juce::jmax (peak, std::abs (left[(size_t) i]), std::abs (right[(size_t) i]));
+            }
+
+            peaks.push_back (peak);
+        }
+
+        // The stage only goes idle once the reported tail is over, so it has
+        // to reach silence on its own well before that
+        const auto firstSilent = std::find_if (peaks.begin(), peaks.end(),
+                                               [] (float p) { return p < StageActivity::silenceThreshold; });
+        const int secondsToSilence = (int) (firstSilent - peaks.begin());
+        logMessage ("peak " + juce::String (peaks[1], 6) + " one second after the impulse, below -100 dBFS after "
+                    + juce::String (secondsToSilence) + " s");
+
+        bool neverGrows = true;
+
+        for (size_t s = 2; s < peaks.size(); ++s)
+            neverGrows = neverGrows && peaks[s] <= peaks[s - 1];
+
+        expect (neverGrows, "repeats never build up");
+        expectLessThan (peaks[1], 0.1f, "repeats already well down after a second");
+        expectLessThan ((double) secondsToSilence, tailSeconds - 1.0, "silent within the reported tail");
+        expect (echo.isAsleep(), "asleep once the reported tail is over");
+    }
+
+    static void processBlock (EchoStage& echo, std::vector<float>& left, std::vector<float>& right)
+    {
+        float* channels[] = { left.data(), right.data() };
+        echo.process (juce::dsp::AudioBlock<float> (channels, 2, (size_t) blockSize));
+    }
+};
+
+static EchoStageTests echoStageTests;
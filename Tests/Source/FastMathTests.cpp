@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    FastMath against std::tanh over +-10, scalar and block versions, with
+    the error bounds documented in FastMath.h.
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DSP/FastMath.h"
+
+class FastMathTests : public juce::UnitTest
+{
+public:
+    FastMathTests() : juce::UnitTest ("FastMath", "HoneyVox") {}
+
+    void runTest() override
+    {
+        std::vector<float> input;
+
+        for (int i = 0; i < numPoints; ++i)
+            input.push_back (-range + 2.0f * range * (float) i / (float) (numPoints - 1));
+
+        beginTest ("tanh");
+        checkAgainstTanh ([] (float x) { return FastMath::tanh (x); }, input, 1.0e-4f);
+        checkClampAndMonotonic (apply ([] (float x) { return FastMath::tanh (x); }, input), input, FastMath::tanhInputLimit);
+
+        beginTest ("tanhCoarse");
+        checkAgainstTanh ([] (float x) { return FastMath::tanhCoarse (x); }, input, 1.5e-3f);
+        checkClampAndMonotonic (apply ([] (float x) { return FastMath::tanhCoarse (x); }, input), input, FastMath::tanhCoarseInputLimit);
+
+        beginTest ("tanhBlock");
+        {
+            auto block = input;
+            FastMath::tanhBlock (block.data(), (int) block.size());
+
+            float maxError = 0.0f;
+
+            for (size_t i = 0; i < input.size(); ++i)
+            {
+                maxError = juce::jmax (maxError, std::abs (block[i] - std::tanh (input[i])));
+                expect (std::abs (block[i] - FastMath::tanh (input[i])) <= 1.0e-7f, "block and scalar disagree");
+            }
+
+            expectLessThan (maxError, 1.0e-4f, "tanhBlock max abs error");
+            checkClampAndMonotonic (block, input, FastMath::tanhInputLimit);
+        }
+
+        beginTest ("softClip / softClipBlock");
+        for (const float drive : { 0.5f, 1.1f, 2.0f, 4.0f })
+        {
+            auto block = input;
+            FastMath::softClipBlock (block.data(), drive, (int) block.size());
+
+            float maxScalarError = 0.0f, maxBlockError = 0.0f, maxCoarseError = 0.0f;
+
+            for (size_t i = 0; i < input.size(); ++i)
+            {
+                const float exact = std::tanh (input[i] * drive) / drive;
+                maxScalarError = juce::jmax (maxScalarError, std::abs (FastMath::softClip (input[i], drive) - exact));
+                maxBlockError = juce::jmax (maxBlockError, std::abs (block[i] - exact));
+                maxCoarseError = juce::jmax (maxCoarseError, std::abs (FastMath::softClipCoarse (input[i], drive) - exact));
+            }
+
+            // The tanh error scales with the 1 / drive output gain
+            expectLessThan (maxScalarError, 1.0e-4f / drive, "softClip max abs error at drive " + juce::String (drive, 1));
+            expectLessThan (maxBlockError, 1.0e-4f / drive, "softClipBlock max abs error at drive " + juce::String (drive, 1));
+            expectLessThan (maxCoarseError, 1.5e-3f / drive, "softClipCoarse max abs error at drive " + juce::String (drive, 1));
+        }
+    }
+
+private:
+    static constexpr int numPoints = 200001;   // 1e-4 steps
+    static constexpr float range = 10.0f;
+
+    // Rounding in the rational part jitters the last few bits next to +-1
+    // (up to 6 ulp for |x| above 3.9), see FastMath.h
+    static constexpr float roundingTolerance = 4.0e-7f;
+
+    template <typename Function>
+    static std::vector<float> apply (Function&& f, const std::vector<float>& input)
+    {
+        std::vector<float> output;
+
+        for (const float x : input)
+            output.push_back (f (x));
+
+        return output;
+    }
+
+    template <typename Function>
+    void checkAgainstTanh (Function&& f, const std::vector<float>& input, float bound)
+    {
+        float maxError = 0.0f;
+
+        for (const float x : input)
+            maxError = juce::jmax (maxError, std::abs (f (x) - std::tanh (x)));
+
+        logMessage ("max abs error " + juce::String (maxError, 7));
+        expectLessThan (maxError, bound, "max abs error");
+    }
+
+    // Bounded to +-1, never decreasing (beyond rounding), and exactly flat
+    // from the clamp point out, so it can't fold back at large inputs
+    void checkClampAndMonotonic (const std::vector<float>& output, const std::vector<float>& input, float clamp)
+    {
+        const auto firstClamped = (size_t) (std::lower_bound (input.begin(), input.end(), clamp) - input.begin());
+        const float atClamp = output[firstClamped];
+        bool bounded = true, monotonic = true, flat = true;
+        float maxBelowClamp = -1.0f;
+
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            bounded = bounded && std::abs (output[i]) <= 1.0f;
+            monotonic = monotonic && (i == 0 || output[i] >= output[i - 1] - roundingTolerance);
+
+            if (input[i] < clamp)
+                maxBelowClamp = juce::jmax (maxBelowClamp, output[i]);
+
+            if (input[i] >= clamp)
+                flat = flat && output[i] == atClamp;
+            else if (input[i] <= -clamp)
+                flat = flat && output[i] == -atClamp;
+        }
+
+        expect (bounded, "output within [-1, 1]");
+        expect (monotonic, "monotonic over +-10");
+        expect (flat, "constant beyond the clamp point");
+        expectGreaterOrEqual (atClamp, maxBelowClamp - roundingTolerance, "clamp value is the maximum");
+    }
+};
+
+static FastMathTests fastMathTests;
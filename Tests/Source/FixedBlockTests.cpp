@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    Host buffer size independence: the same input through FixedBlockFifo
+    and the full stage chain (in processStages order) must give the same
+    output to the bit whether the host sends blocks of 64 or odd sizes, in
+    stereo and in mono. DryDelay must hand back the input exactly one
+    latency late across the switch from recording to bypass.
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DSP/FixedBlockFifo.h"
+#include "DSP/HoneyStage.h"
+#include "DSP/PhoneStage.h"
+#include "DSP/UnderwaterStage.h"
+#include "DSP/EchoStage.h"
+#include "DSP/HumStage.h"
+#include "DSP/OutputStage.h"
+
+class FixedBlockTests : public juce::UnitTest
+{
+public:
+    FixedBlockTests() : juce::UnitTest ("Fixed internal blocks", "HoneyVox") {}
+
+    void runTest() override
+    {
+        const auto input = makeInput();
+
+        beginTest ("Stage chain output is bit-identical at any host block size");
+        {
+            const auto reference = render (input, { 64 }, false);
+
+            for (const auto& sizes : { std::vector<int> { 1, 17, 333, 4096 },
+                                       std::vector<int> { 4096 },
+                                       std::vector<int> { 63, 65, 1 } })
+            {
+                const auto output = render (input, sizes, false);
+                expect (output == reference, "differs with host blocks " + describe (sizes));
+            }
+
+            expect (std::any_of (reference.left.begin(), reference.left.end(), [] (float x) { return x != 0.0f; }),
+                    "the chain produced output");
+        }
+
+        beginTest ("Mono hosts get the left channel of the same output");
+        {
+            auto monoInput = input;
+            monoInput.right = monoInput.left;
+
+            const auto stereo = render (monoInput, { 64 }, false);
+            const auto mono = render (monoInput, { 1, 17, 333, 4096 }, true);
+            expect (mono.left == stereo.left, "mono output differs");
+        }
+
+        beginTest ("DryDelay is exactly one latency late across the bypass switch");
+        for (const int latency : { 0, 64, 64 + 384, 1000 })
+            checkDryDelay (input, latency);
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int internalBlockSize = 64;
+    static constexpr double seconds = 3.0;
+
+    struct Signal
+    {
+        std::vector<float> left, right;
+        bool operator== (const Signal& other) const   { return left == other.left && right == other.right; }
+    };
+
+    // A vowel-like harmonic series with noise and a few gaps of silence, so
+    // the stages' idle paths and the echo's repeats both get exercised
+    static Signal makeInput()
+    {
+        juce::Random random (1234);
+        const int numSamples = (int) (sampleRate * seconds);
+        Signal input { std::vector<float> ((size_t) numSamples), std::vector<float> ((size_t) numSamples) };
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            const bool voiced = (n / 24000) % 3 != 2;
+            float x = 0.0f;
+
+            for (int h = 1; voiced && h <= 12; ++h)
+                x += (float) std::sin (juce::MathConstants<double>::twoPi * 180.0 * h * n / sampleRate) * 0.25f / (float) h;
+
+            input.left[(size_t) n] = voiced ? x + 0.02f * (random.nextFloat() - 0.5f) : 0.0f;
+            input.right[(size_t) n] = voiced ? 0.8f * x - 0.02f * (random.nextFloat() - 0.5f) : 0.0f;
+        }
+
+        return input;
+    }
+
+    // Every stage on, with a parameter change partway through so the
+    // snapshot-per-internal-block timing has to line up too
+    struct Chain
+    {
+        HoneyStage honey;
+        PhoneStage phone;
+        UnderwaterStage underwater;
+        EchoStage echo;
+        HumStage hum;
+        OutputStage output;
+        FilterCoefficientEngine coefficients;
+        int blockIndex = 0;
+
+        Chain()
+        {
+            const juce::dsp::ProcessSpec spec { sampleRate, (juce::uint32) internalBlockSize, 2 };
+            honey.prepare (spec);
+            phone.prepare (spec);
+            underwater.prepare (spec);
+            echo.prepare (spec);
+            hum.prepare (spec);
+            output.prepare (spec);
+
+            coefficients.prepare();
+            coefficients.updateDelayFeedback (echo.getInternalSampleRate());
+            echo.setCoefficients (coefficients.getDelayFeedback());
+
+            honey.setEnabled (true, true);
+            honey.setAmount (0.6f);
+            honey.setAntiAliasing (true);
+            phone.setEnabled (true, true);
+            phone.setMode (2);
+            phone.setCodecEnabled (true);
+            phone.setAmount (0.7f);
+            underwater.setEnabled (true, true);
+            underwater.setAmount (0.4f);
+            echo.setEnabled (true, true);
+            echo.setMix (0.5f);
+            echo.setFeedback (0.5f);
+            echo.setNumTaps (3);
+
+            for (int k = 0; k < 3; ++k)
+            {
+                echo.setTapTimeMs (k, 120.0f + 90.0f * (float) k);
+                echo.setTapLevel (k, 0.8f);
+                echo.setTapPan (k, k == 1 ? -0.5f : 0.5f);
+            }
+
+            hum.setAmount (0.1f);
+            output.setGain (0.9f);
+        }
+
+        void process (const juce::dsp::AudioBlock<float>& block)
+        {
+            if (++blockIndex == 1000)
+            {
+                honey.setAmount (0.9f);
+                echo.setFeedback (0.7f);
+                echo.setTapTimeMs (0, 200.0f);
+            }
+
+            honey.process (block);
+            phone.process (block);
+            underwater.process (block);
+            echo.process (block);
+            hum.process (block);
+            output.process (block);
+        }
+    };
+
+    static Signal render (const Signal& input, const std::vector<int>& hostBlockSizes, bool mono)
+    {
+        auto chain = std::make_unique<Chain>();
+        FixedBlockFifo fifo;
+        fifo.prepare (internalBlockSize);
+
+        auto output = input;
+        const int numSamples = (int) output.left.size();
+        size_t sizeIndex = 0;
+
+        for (int start = 0; start < numSamples;)
+        {
+            const int num = juce::jmin (numSamples - start, hostBlockSizes[sizeIndex++ % hostBlockSizes.size()]);
+            fifo.process (output.left.data() + start, mono ? nullptr : output.right.data() + start, num,
+                          [&chain] (const juce::dsp::AudioBlock<float>& block) { chain->process (block); });
+            start += num;
+        }
+
+        return output;
+    }
+
+    // Records in odd blocks (as processBlock does), then bypasses in other
+    // odd blocks, including ones longer than the ring
+    void checkDryDelay (const Signal& input, int latency)
+    {
+        DryDelay delay;
+        delay.prepare (latency);
+        expectGreaterOrEqual (delay.getMaxDelaySamples(), latency);
+
+        auto output = input;
+        const int numSamples = (int) output.left.size();
+        const int bypassStart = numSamples / 3 + 7;
+        const int recordSizes[] = { 1, 17, 333, 4096 }, bypassSizes[] = { 5, 4096, 64, 1 };
+        int index = 0;
+
+        for (int start = 0; start < numSamples; ++index)
+        {
+            const bool bypassed = start >= bypassStart;
+            const int size = bypassed ? bypassSizes[index % 4] : recordSizes[index % 4];
+            const int num = juce::jmin (numSamples - start, bypassed ? size : juce::jmin (size, bypassStart - start));
+            auto* left = output.left.data() + start;
+            auto* right = output.right.data() + start;
+
+            if (bypassed)
+                delay.process (left, right, num, latency);
+            else
+                delay.write (left, right, num);
+
+            start += num;
+        }
+
+        bool exact = true;
+
+        for (int n = bypassStart; n < numSamples; ++n)
+        {
+            const float expectedL = n >= latency ? input.left[(size_t) (n - latency)] : 0.0f;
+            const float expectedR = n >= latency ? input.right[(size_t) (n - latency)] : 0.0f;
+            exact = exact && output.left[(size_t) n] == expectedL && output.right[(size_t) n] == expectedR;
+        }
+
+        expect (exact, "dry signal not delayed by exactly " + juce::String (latency) + " samples");
+    }
+
+    static juce::String describe (const std::vector<int>& sizes)
+    {
+        juce::StringArray names;
+
+        for (const int size : sizes)
+            names.add (juce::String (size));
+
+        return names.joinIntoString ("/");
+    }
+};
+
+static FixedBlockTests fixedBlockTests;
@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    Test runner for the DSP sources.
+    Runs every juce::UnitTest in the "HoneyVox" category and exits non-zero
+    on any failure. With --benchmarks it runs the "Benchmarks" category
+    instead, which only logs timings and memory and checks the CPU budgets.
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+int main (int argc, char* argv[])
+{
+    const juce::StringArray args (argv + 1, argc - 1);
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure (false);
+    runner.runTestsInCategory (args.contains ("--benchmarks") ? "Benchmarks" : "HoneyVox");
+
+    int failures = 0;
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        failures += runner.getResult (i)->failures;
+
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    CPU budget for the Mobile GSM path (see GSMCodec.h): the whole phone
+    stage in Mobile mode with the codec on must stay under 1.5 % of one core
+    per instance, so 30 tracks fit in half a core. Run on a Release build
+    with --benchmarks.
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DSP/PhoneStage.h"
+
+class PhoneCodecBenchmark : public juce::UnitTest
+{
+public:
+    PhoneCodecBenchmark() : juce::UnitTest ("Phone GSM codec", "Benchmarks") {}
+
+    void runTest() override
+    {
+        for (const double rate : { 44100.0, 48000.0, 96000.0 })
+        {
+            beginTest ("Mobile + codec at " + juce::String (rate, 0) + " Hz");
+
+            const double withCodec = measure (rate, true);
+            const double withoutCodec = measure (rate, false);
+
+            logMessage ("phone stage " + juce::String (withCodec, 3) + " % of a core with the codec, "
+                        + juce::String (withoutCodec, 3) + " % without");
+            expectLessThan (withCodec, budgetPercent, "CPU budget per instance");
+        }
+    }
+
+private:
+    static constexpr double budgetPercent = 1.5;
+    static constexpr int blockSize = 64;   // the processor's internal block size
+    static constexpr double seconds = 10.0;
+
+    // Percent of one core to run the phone stage in real time
+    double measure (double rate, bool codecEnabled)
+    {
+        PhoneStage phone;
+        phone.prepare ({ rate, (juce::uint32) blockSize, 2 });
+        phone.setMode (2);
+        phone.setAmount (0.8f);
+        phone.setCodecEnabled (codecEnabled);
+        phone.setEnabled (true, true);
+
+        // Vowel-like test signal: a 140 Hz harmonic series plus a little noise
+        const int numSamples = (int) (rate * seconds);
+        std::vector<float> left ((size_t) numSamples), right ((size_t) numSamples);
+        auto random = getRandom();
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float x = 0.0f;
+
+            for (int h = 1; h <= 20; ++h)
+                x += (float) std::sin (juce::MathConstants<double>::twoPi * 140.0 * h * n / rate) * 0.3f / (float) h;
+
+            left[(size_t) n] = x + 0.01f * (random.nextFloat() - 0.5f);
+            right[(size_t) n] = 0.9f * left[(size_t) n];
+        }
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+
+        for (int start = 0; start + blockSize <= numSamples; start += blockSize)
+        {
+            float* channels[] = { left.data() + start, right.data() + start };
+            phone.process (juce::dsp::AudioBlock<float> (channels, 2, (size_t) blockSize));
+        }
+
+        const double elapsed = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - startTicks);
+        return 100.0 * elapsed / seconds;
+    }
+};
+
+static PhoneCodecBenchmark phoneCodecBenchmark;
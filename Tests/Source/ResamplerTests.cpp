@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    RationalResampler round trips at the phone stage's internal rates: the
+    GSM path's 8 kHz must be exact and the reported latency must line the
+    output up with the input, whatever the block sizes. PolyphaseResampler
+    skipSilence(), used by the bypassed echo, must track decimate().
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DSP/PolyphaseResampler.h"
+#include "DSP/GSMCodec.h"
+
+class ResamplerTests : public juce::UnitTest
+{
+public:
+    ResamplerTests() : juce::UnitTest ("Resamplers", "HoneyVox") {}
+
+    void runTest() override
+    {
+        // Phone internal rates for 44.1, 48, 88.2, 176.4 kHz and 32 kHz hosts
+        for (const double rate : { 22050.0, 16000.0, 17640.0, 176400.0 / 11.0 })
+        {
+            beginTest ("8 kHz round trip from " + juce::String (rate, 1) + " Hz");
+            checkRoundTrip (rate, GSMCodec::sampleRate, GSMCodec::frameSize);
+        }
+
+        beginTest ("Round trip without an internal delay");
+        checkRoundTrip (22050.0, 8000.0, 0);
+        checkRoundTrip (44100.0, 16000.0, 0);
+
+        beginTest ("PolyphaseResampler::skipSilence keeps the decimator phase");
+        for (const int factor : { 1, 2, 4 })
+            checkSkipSilence (factor);
+    }
+
+private:
+    void checkRoundTrip (double hostRate, double internalRate, int internalDelay)
+    {
+        constexpr int maxBlock = 64;
+        constexpr float frequency = 1000.0f;
+
+        RationalResampler resampler;
+        resampler.prepare (hostRate, internalRate, maxBlock, GSMCodecPath::resamplerTapsPerPhase, internalDelay);
+        expectWithinAbsoluteError (resampler.getInternalSampleRate(), internalRate, 1.0e-6, "internal rate is exact");
+
+        const int latency = resampler.getLatencySamples();
+        const int numSamples = latency + (int) hostRate;   // one second past the latency
+
+        std::vector<SIMDFloat> narrow ((size_t) resampler.getMaxInternalSamples (maxBlock));
+        std::vector<SIMDFloat> held ((size_t) juce::jmax (1, internalDelay), SIMDFloat::expand (0.0f));
+        std::vector<float> output;
+        int heldPos = 0;
+
+        // Odd block sizes so the decimator and interpolator cross block edges at every phase
+        const int blockSizes[] = { 64, 1, 17, 33, 5, 64, 63 };
+        int blockIndex = 0;
+
+        for (int start = 0; start < numSamples;)
+        {
+            const int num = juce::jmin (blockSizes[blockIndex++ % 7], numSamples - start);
+            SIMDFloat block[maxBlock];
+
+            for (int i = 0; i < num; ++i)
+                block[i] = SIMDFloat::expand (input (start + i, hostRate, frequency));
+
+            const int numNarrow = resampler.decimate (block, num, narrow.data());
+
+            for (int j = 0; j < numNarrow && internalDelay > 0; ++j)
+            {
+                std::swap (narrow[(size_t) j], held[(size_t) heldPos]);
+                heldPos = (heldPos + 1) % internalDelay;
+            }
+
+            resampler.interpolate (narrow.data(), block, num);
+
+            for (int i = 0; i < num; ++i)
+                output.push_back (block[i].get (0));
+
+            start += num;
+        }
+
+        // Skip the filters' start-up, then the output is the input delayed by the latency
+        float maxError = 0.0f;
+
+        for (int n = latency + (int) (0.05 * hostRate); n < numSamples; ++n)
+            maxError = juce::jmax (maxError, std::abs (output[(size_t) n] - input (n - latency, hostRate, frequency)));
+
+        logMessage ("latency " + juce::String (latency) + ", max error " + juce::String (maxError, 6));
+        expectLessThan (maxError, 1.0e-3f, "1 kHz comes back aligned with the reported latency");
+    }
+
+    // Skipping must count exactly the internal samples decimate() produces
+    // for the same block sizes and leave the phase where decimate() would
+    void checkSkipSilence (int factor)
+    {
+        constexpr int maxBlock = 64;
+        PolyphaseResampler decimating, skipping;
+        decimating.prepare (factor, maxBlock);
+        skipping.prepare (factor, maxBlock);
+
+        std::vector<SIMDFloat> silence ((size_t) maxBlock, SIMDFloat::expand (0.0f));
+        std::vector<SIMDFloat> narrow ((size_t) decimating.getMaxInternalSamples (maxBlock));
+        auto random = getRandom();
+        bool countsMatch = true;
+
+        for (int block = 0; block < 1000; ++block)
+        {
+            const int num = 1 + random.nextInt (maxBlock);
+            countsMatch = countsMatch && decimating.decimate (silence.data(), num, narrow.data())
+                                         == skipping.skipSilence (num);
+        }
+
+        expect (countsMatch, "same internal sample count at factor " + juce::String (factor));
+        expectEquals (decimating.decimate (silence.data(), maxBlock, narrow.data()),
+                      skipping.decimate (silence.data(), maxBlock, narrow.data()),
+                      "decimate() carries on in step at factor " + juce::String (factor));
+    }
+
+    static float input (int n, double rate, float frequency) noexcept
+    {
+        return 0.5f * (float) std::sin (juce::MathConstants<double>::twoPi * frequency * n / rate);
+    }
+};
+
+static ResamplerTests resamplerTests;
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+    HoneyVox Ad-Lib FX
+    Created by Nolo's Addiction
+
+    StereoDelayBuffer storage formats: what is written comes back at the
+    requested delay, within each format's quantisation, and the int16
+    dither and half-float rounding land on the noise floors documented in
+    StereoDelayBuffer.h.
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DSP/StereoDelayBuffer.h"
+
+class StereoDelayBufferTests : public juce::UnitTest
+{
+public:
+    StereoDelayBufferTests() : juce::UnitTest ("StereoDelayBuffer", "HoneyVox") {}
+
+    void runTest() override
+    {
+        beginTest ("float32 round trip");
+        {
+            // Only the interpolator's own rounding (x0 + 1 * (x1 - x0))
+            const auto error = roundTrip (DelayStorage::float32, 0.5f);
+            expectLessThan (error.maxAbs, 1.0e-7f, "float rounding only");
+        }
+
+        beginTest ("int16 round trip and dither noise floor");
+        {
+            // Rounding plus TPDF dither: error within 1.5 LSB, total power LSB^2 / 4 (-84.3 dBFS)
+            const auto error = roundTrip (DelayStorage::int16, 0.5f);
+            logMessage ("error " + juce::String (error.rmsDecibels, 1) + " dBFS rms, mean " + juce::String (error.mean, 8));
+            expectLessOrEqual (error.maxAbs, 1.5f / 8192.0f, "within 1.5 LSB");
+            expectGreaterThan (error.rmsDecibels, -86.0f, "dither is there");
+            expectLessThan (error.rmsDecibels, -82.0f, "noise floor around -84 dBFS");
+            expectLessThan (std::abs (error.mean), 2.0e-6f, "no DC from the rounding");
+
+            // The dither decorrelates the error from the signal, so a quieter signal sees the same floor
+            const auto quiet = roundTrip (DelayStorage::int16, 0.01f);
+            expectWithinAbsoluteError (quiet.rmsDecibels, error.rmsDecibels, 1.0f, "floor independent of level");
+
+            const auto hot = roundTrip (DelayStorage::int16, 3.5f);
+            expectLessOrEqual (hot.maxAbs, 1.5f / 8192.0f, "+10 dB peaks still fit");
+        }
+
+        beginTest ("float16 round trip");
+        {
+            // Round to nearest even on an 11-bit significand: relative error <= 2^-11
+            const auto error = roundTrip (DelayStorage::float16, 0.5f);
+            logMessage ("relative error " + juce::String (error.maxRelative, 7) + " max, "
+                        + juce::String (error.rmsRelativeDecibels, 1) + " dB rms");
+            expectLessOrEqual (error.maxRelative, 1.0f / 2048.0f, "half-float rounding");
+            expectLessThan (error.rmsRelativeDecibels, -66.0f, "~-66 dB relative error or better");
+
+            // Far above 0 dBFS nothing clips
+            const auto hot = roundTrip (DelayStorage::float16, 100.0f);
+            expectLessOrEqual (hot.maxRelative, 1.0f / 2048.0f, "no clipping at +40 dB");
+        }
+
+        beginTest ("Compressed storage halves the memory");
+        {
+            StereoDelayBuffer buffer;
+            buffer.prepare (96000, 64, DelayStorage::float32);
+            const auto floatBytes = buffer.getMemoryBytes();
+
+            for (const auto storage : { DelayStorage::int16, DelayStorage::float16 })
+            {
+                buffer.prepare (96000, 64, storage);
+                expectEquals ((juce::int64) buffer.getMemoryBytes() * 2, (juce::int64) floatBytes);
+            }
+        }
+    }
+
+private:
+    struct Error
+    {
+        float maxAbs = 0.0f, mean = 0.0f, rmsDecibels = -200.0f;
+        float maxRelative = 0.0f, rmsRelativeDecibels = -200.0f;
+    };
+
+    // A 441 Hz sine (never an exact multiple of the int16 step) written in
+    // blocks and read back with linear interpolation at a whole-sample delay,
+    // which returns the stored samples (up to one float rounding)
+    static Error roundTrip (DelayStorage storage, float amplitude)
+    {
+        constexpr int blockSize = 64, delay = 1000, numSamples = 96000;
+
+        StereoDelayBuffer buffer;
+        buffer.prepare (4096, blockSize, storage);
+        buffer.setInterpolation (DelayInterpolation::linear);
+
+        std::vector<float> input ((size_t) numSamples);
+
+        for (int n = 0; n < numSamples; ++n)
+            input[(size_t) n] = amplitude * (float) std::sin (juce::MathConstants<double>::twoPi * 441.0 * n / 48000.0 + 0.1);
+
+        const std::vector<float> delays ((size_t) blockSize, (float) delay);
+        float outL[blockSize], outR[blockSize];
+        double sum = 0.0, sumSquares = 0.0, signalSquares = 0.0;
+        Error error;
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            buffer.read (delays.data(), delays.data(), outL, outR, blockSize);
+            buffer.write (input.data() + start, input.data() + start, blockSize);
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const int source = start + i - delay;
+
+                if (source < 0)
+                    continue;
+
+                const float x = input[(size_t) source];
+                const float e = outL[i] - x;
+
+                error.maxAbs = juce::jmax (error.maxAbs, std::abs (e), std::abs (outR[i] - x));
+                sum += e;
+                sumSquares += (double) e * e;
+                signalSquares += (double) x * x;
+
+                if (std::abs (x) > 1.0e-3f * amplitude)
+                    error.maxRelative = juce::jmax (error.maxRelative, std::abs (e / x));
+            }
+        }
+
+        const int count = numSamples - delay;
+        error.mean = (float) (sum / count);
+        error.rmsDecibels = juce::Decibels::gainToDecibels ((float) std::sqrt (sumSquares / count), -200.0f);
+        error.rmsRelativeDecibels = juce::Decibels::gainToDecibels ((float) std::sqrt (sumSquares / signalSquares), -200.0f);
+        return error;
+    }
+};
+
+static StereoDelayBufferTests stereoDelayBufferTests;